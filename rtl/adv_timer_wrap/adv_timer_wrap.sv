@@ -0,0 +1,220 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Authors:
+// - Nico Canzani <ncanzani@student.ethz.ch>
+
+// gives us the `FF(...) macro making it easy to have properly defined flip-flops
+`include "common_cells/registers.svh"
+
+// Advanced timer with an OBI subordinate port
+// Drives the APB port of apb_adv_timer directly instead of going through periph_to_reg and
+// reg_to_apb, which take three cycles per access and cannot accept back-to-back transactions.
+// The timer register file is always ready (PREADY high) and acts on PSEL & PENABLE, so the APB
+// setup and access phases are merged: every request is granted in the cycle it is issued and
+// the response follows in the next one, like the other OBI subordinates.
+//
+// Input capture: selected edges of one GPIO input push a timestamp into a FIFO. The counters of
+// apb_adv_timer are not visible outside of it, so timestamps come from a free-running counter of
+// the system clock in the wrapper (cycle resolution, wraps after 2^30 cycles). Writing CAP_CFG
+// does not capture an edge, the new pin is compared against its own level.
+// Capture registers (offsets from the adv timer base address, not forwarded to the timer):
+// 0x200 CAP_CFG    [4:0] pin, [5] rising edges, [6] falling edges, [15:8] irq threshold
+//                  (irq_o while at least this many entries are queued, 0: off)
+// 0x204 CAP_STATUS [7:0] queued entries, [8] overflow (edge lost on a full FIFO, write 1 to clear)
+// 0x208 CAP_DATA   read: pops the oldest entry, [31] valid, [30] pin level after the edge
+//                  (1: rising edge), [29:0] timestamp; 0 (not valid) if empty. Can be read in
+//                  bursts (also by the DMA).
+// 0x20C CAP_TIME   read: current timestamp
+// 0x210 CAP_FLUSH  write: drop all entries
+module adv_timer_wrap #(
+  /// The OBI configuration of the subordinate port.
+  parameter obi_pkg::obi_cfg_t ObiCfg       = obi_pkg::ObiDefaultConfig,
+  /// The request struct.
+  parameter type               obi_req_t    = logic,
+  /// The response struct.
+  parameter type               obi_rsp_t    = logic,
+  /// Number of external input signals.
+  parameter int unsigned       ExtSigNum    = 32,
+  /// Entries of the capture FIFO (max 255).
+  parameter int unsigned       CaptureDepth = 8
+) (
+  input  logic                 clk_i,
+  input  logic                 rst_ni,
+  input  logic                 testmode_i,
+
+  input  obi_req_t             obi_req_i,
+  output obi_rsp_t             obi_rsp_o,
+
+  input  logic                 dft_cg_enable_i,
+  /// Timer clock if a timer selects the low speed clock (TIM_CFG_SEL_CLK_SRC cleared)
+  input  logic                 low_speed_clk_i,
+  input  logic [ExtSigNum-1:0] ext_sig_i,
+  /// Synchronized inputs for the capture unit
+  input  logic [ExtSigNum-1:0] cap_sig_i,
+  /// Capture FIFO holds at least the threshold number of entries
+  output logic                 cap_irq_o,
+  /// One event line per timer, see REG_EVENT_CFG
+  output logic [3:0]           events_o,
+  output logic [3:0]           ch_0_o,
+  output logic [3:0]           ch_1_o,
+  output logic [3:0]           ch_2_o,
+  output logic [3:0]           ch_3_o
+);
+
+  localparam logic [11:0] CapBaseAddr   = 12'h200;
+  localparam logic [11:0] CapCfgAddr    = 12'h200;
+  localparam logic [11:0] CapStatusAddr = 12'h204;
+  localparam logic [11:0] CapDataAddr   = 12'h208;
+  localparam logic [11:0] CapTimeAddr   = 12'h20C;
+  localparam logic [11:0] CapFlushAddr  = 12'h210;
+
+  logic [11:0] addr;
+  logic        cap_sel; // request goes to the capture registers
+  assign addr    = obi_req_i.a.addr[11:0];
+  assign cap_sel = (addr >= CapBaseAddr);
+
+  logic [31:0] prdata;
+  logic        pready, pslverr;
+
+  apb_adv_timer #(
+    .APB_ADDR_WIDTH ( 12        ),
+    .EXTSIG_NUM     ( ExtSigNum )
+  ) i_apb_adv_timer (
+    .HCLK            ( clk_i                    ),
+    .HRESETn         ( rst_ni                   ),
+
+    .PADDR           ( obi_req_i.a.addr[11:0]   ),
+    .PWDATA          ( obi_req_i.a.wdata        ),
+    .PWRITE          ( obi_req_i.a.we           ),
+    .PSEL            ( obi_req_i.req & ~cap_sel ),
+    .PENABLE         ( obi_req_i.req & ~cap_sel ),
+    .PRDATA          ( prdata                   ),
+    .PREADY          ( pready                   ),
+    .PSLVERR         ( pslverr                  ),
+
+    .dft_cg_enable_i ( dft_cg_enable_i          ),
+    .low_speed_clk_i ( low_speed_clk_i          ),
+    .ext_sig_i       ( ext_sig_i                ),
+    .events_o        ( events_o                 ),
+    .ch_0_o          ( ch_0_o                   ),
+    .ch_1_o          ( ch_1_o                   ),
+    .ch_2_o          ( ch_2_o                   ),
+    .ch_3_o          ( ch_3_o                   )
+  );
+
+  // -------------
+  // Input capture
+  // -------------
+  typedef logic [31:0] cap_entry_t;
+
+  logic [ 4:0] cap_pin_d, cap_pin_q;
+  logic        cap_rise_d, cap_rise_q, cap_fall_d, cap_fall_q;
+  logic [ 7:0] cap_thresh_d, cap_thresh_q;
+  logic        cap_ovf_d, cap_ovf_q;
+  logic [29:0] cap_time_q;
+  logic        cap_level, cap_level_q, cap_edge;
+  logic        cap_push, cap_pop, cap_flush, cap_full, cap_empty;
+  logic [ 7:0] cap_count;
+  logic [cf_math_pkg::idx_width(CaptureDepth)-1:0] cap_usage;
+  cap_entry_t  cap_head;
+  logic [31:0] cap_rdata;
+
+  assign cap_level = cap_sig_i[cap_pin_q];
+  assign cap_edge  = (cap_rise_q &  cap_level & ~cap_level_q) |
+                     (cap_fall_q & ~cap_level &  cap_level_q);
+  assign cap_push  = cap_edge & ~cap_full;
+  assign cap_count = cap_full ? 8'(CaptureDepth) : 8'(cap_usage);
+
+  always_comb begin
+    cap_pin_d    = cap_pin_q;
+    cap_rise_d   = cap_rise_q;
+    cap_fall_d   = cap_fall_q;
+    cap_thresh_d = cap_thresh_q;
+    cap_ovf_d    = cap_ovf_q | (cap_edge & cap_full);
+    cap_pop      = 1'b0;
+    cap_flush    = 1'b0;
+    cap_rdata    = '0;
+
+    if (obi_req_i.req && cap_sel && obi_req_i.a.we) begin
+      if (addr == CapCfgAddr) begin
+        cap_pin_d    = obi_req_i.a.wdata[4:0];
+        cap_rise_d   = obi_req_i.a.wdata[5];
+        cap_fall_d   = obi_req_i.a.wdata[6];
+        cap_thresh_d = obi_req_i.a.wdata[15:8];
+      end
+      if (addr == CapStatusAddr && obi_req_i.a.wdata[8])
+        cap_ovf_d = 1'b0;
+      if (addr == CapFlushAddr)
+        cap_flush = 1'b1;
+    end else if (obi_req_i.req && cap_sel) begin
+      unique case (addr)
+        CapCfgAddr:    cap_rdata = {16'b0, cap_thresh_q, 1'b0, cap_fall_q, cap_rise_q, cap_pin_q};
+        CapStatusAddr: cap_rdata = {23'b0, cap_ovf_q, cap_count};
+        CapDataAddr: begin
+          cap_pop   = ~cap_empty;
+          cap_rdata = cap_empty ? '0 : cap_head;
+        end
+        CapTimeAddr:   cap_rdata = {2'b0, cap_time_q};
+        default: ;
+      endcase
+    end
+  end
+
+  `FF(cap_pin_q,    cap_pin_d,    '0)
+  `FF(cap_rise_q,   cap_rise_d,   '0)
+  `FF(cap_fall_q,   cap_fall_d,   '0)
+  `FF(cap_thresh_q, cap_thresh_d, '0)
+  `FF(cap_ovf_q,    cap_ovf_d,    '0)
+  `FF(cap_time_q,   cap_time_q + 30'd1, '0)
+  // from the pin selected next cycle, so a CAP_CFG write does not look like an edge
+  `FF(cap_level_q,  cap_sig_i[cap_pin_d], '0)
+
+  fifo_v3 #(
+    .FALL_THROUGH ( 1'b0         ),
+    .DEPTH        ( CaptureDepth ),
+    .dtype        ( cap_entry_t  )
+  ) i_cap_fifo (
+    .clk_i,
+    .rst_ni,
+    .flush_i    ( cap_flush                ),
+    .testmode_i,
+    .full_o     ( cap_full                 ),
+    .empty_o    ( cap_empty                ),
+    .usage_o    ( cap_usage                ),
+    .data_i     ( {1'b1, cap_level, cap_time_q} ),
+    .push_i     ( cap_push                 ),
+    .data_o     ( cap_head                 ),
+    .pop_i      ( cap_pop                  )
+  );
+
+  assign cap_irq_o = (cap_thresh_q != '0) && (cap_count >= cap_thresh_q);
+
+  // ------------
+  // OBI response
+  // ------------
+  logic                       rsp_valid_d, rsp_valid_q;
+  logic                       rsp_err_d, rsp_err_q;
+  logic [ObiCfg.IdWidth-1:0]  rsp_id_d, rsp_id_q;
+  logic [ObiCfg.DataWidth-1:0] rsp_data_d, rsp_data_q;
+
+  assign obi_rsp_o.gnt = obi_req_i.req & (cap_sel | pready);
+
+  assign rsp_valid_d = obi_rsp_o.gnt;
+  assign rsp_err_d   = ~cap_sel & pslverr;
+  assign rsp_id_d    = obi_req_i.a.aid;
+  assign rsp_data_d  = cap_sel ? cap_rdata : prdata;
+
+  `FF(rsp_valid_q, rsp_valid_d, '0)
+  `FF(rsp_err_q,   rsp_err_d,   '0)
+  `FF(rsp_id_q,    rsp_id_d,    '0)
+  `FF(rsp_data_q,  rsp_data_d,  '0)
+
+  assign obi_rsp_o.rvalid       = rsp_valid_q;
+  assign obi_rsp_o.r.rdata      = rsp_data_q;
+  assign obi_rsp_o.r.rid        = rsp_id_q;
+  assign obi_rsp_o.r.err        = rsp_err_q;
+  assign obi_rsp_o.r.r_optional = '0;
+
+endmodule
@@ -56,11 +56,11 @@ module core_wrap import croc_pkg::*; #() (
     .PMPEnable          ( 1'b0                ),
     .PMPGranularity     ( 0                   ),
     .PMPNumRegions      ( 4                   ),
-    .MHPMCounterNum     ( 0                   ),
-    .MHPMCounterWidth   ( 40                  ),
+    .MHPMCounterNum     ( HpmCounterNum       ),
+    .MHPMCounterWidth   ( HpmCounterWidth     ),
     .RV32E              ( 0                   ),
-    .RV32M              ( cve2_pkg::RV32MNone ),
-    .RV32B              ( cve2_pkg::RV32BNone ),
+    .RV32M              ( Rv32M               ),
+    .RV32B              ( Rv32B               ),
     .DbgTriggerEn       ( 1'b1                ),
     .DbgHwBreakNum      ( 1                   ),
     .DmHaltAddr         ( DebugAddrOffset + dm::HaltAddress[31:0]      ),
@@ -70,6 +70,9 @@ module croc_domain import croc_pkg::*; #(
   logic timer0_irq0;
   logic timer0_irq1;
   logic adv_timer0_irq0;
+  logic pulser_irq;
+  logic adv_timer_cap_irq;
+  logic gpio_stream_irq;
 
   logic [15:0] interrupts;
 
@@ -80,6 +83,9 @@ module croc_domain import croc_pkg::*; #(
     interrupts[2] = gpio_irq;
     interrupts[3+:NumExternalIrqs] = interrupts_i;
     interrupts[3+NumExternalIrqs] = adv_timer0_irq0;
+    interrupts[4+NumExternalIrqs] = pulser_irq;
+    interrupts[5+NumExternalIrqs] = adv_timer_cap_irq;
+    interrupts[6+NumExternalIrqs] = gpio_stream_irq;
   end
 
   // ----------------------------
@@ -333,6 +339,17 @@ module croc_domain import croc_pkg::*; #(
   // Main Interconnect
   // -----------------
 
+  // SRAM bank interleaving: the manager addresses are remapped so the xbar rules
+  // and the banks keep their contiguous layout (no-op unless SramInterleave is set)
+  mgr_obi_req_t [NumXbarManagers-1:0] xbar_mgr_obi_req;
+
+  always_comb begin
+    xbar_mgr_obi_req = {core_instr_obi_req, core_data_obi_req, dbg_req_obi_req, user_mgr_obi_req_i};
+    for (int unsigned i = 0; i < NumXbarManagers; i++) begin
+      xbar_mgr_obi_req[i].a.addr = sram_addr_remap(xbar_mgr_obi_req[i].a.addr);
+    end
+  end
+
   obi_xbar #(
     .SbrPortObiCfg      ( MgrObiCfg        ),
     .MgrPortObiCfg      ( SbrObiCfg        ),
@@ -354,7 +371,7 @@ module croc_domain import croc_pkg::*; #(
     .rst_ni,
     .testmode_i,
 
-    .sbr_ports_req_i  ( {core_instr_obi_req, core_data_obi_req, dbg_req_obi_req, user_mgr_obi_req_i } ), // from managers towards subordinates
+    .sbr_ports_req_i  ( xbar_mgr_obi_req ), // from managers towards subordinates
     .sbr_ports_rsp_o  ( {core_instr_obi_rsp, core_data_obi_rsp, dbg_req_obi_rsp, user_mgr_obi_rsp_o } ),
     .mgr_ports_req_o  ( all_sbr_obi_req ), // connections to subordinates
     .mgr_ports_rsp_i  ( all_sbr_obi_rsp ),
@@ -591,6 +608,7 @@ module croc_domain import croc_pkg::*; #(
     .gpio_out_en_o,          
     .gpio_in_sync_o,       
     .interrupt_o    ( gpio_irq     ),
+    .stream_irq_o   ( gpio_stream_irq ),
     .obi_req_i      ( gpio_obi_req ),
     .obi_rsp_o      ( gpio_obi_rsp )
   );
@@ -624,72 +642,52 @@ module croc_domain import croc_pkg::*; #(
   assign timer_obi_rsp.r.err        = 1'b0;
   assign timer_obi_rsp.r.r_optional = 1'b0;
 
-  // Pulser Subordinate
-    pulser #(
+  // Pulser Subordinate, with a configuration queue per instance
+  pulser_wrap #(
     .ObiCfg           ( SbrObiCfg         ),
     .obi_req_t        ( sbr_obi_req_t     ),
     .obi_rsp_t        ( sbr_obi_rsp_t     ),
+    .obi_a_chan_t     ( sbr_obi_a_chan_t  ),
+    .obi_r_chan_t     ( sbr_obi_r_chan_t  ),
     .reg_req_t        ( reg_req_t         ),
     .reg_rsp_t        ( reg_rsp_t         ),
-    .N_PULSER_INST    ( N_PULSER_INST     )
-    ) i_pulser (
+    .N_PULSER_INST    ( N_PULSER_INST     ),
+    .QueueDepth       ( PulserQueueDepth  ),
+    .BaseAddr         ( PulserAddrOffset  ),
+    .NumTrigEvents    ( 4                 ),
+    .GpioCount        ( GpioCount         )
+  ) i_pulser_wrap (
     .clk_i            ( clk_i             ),
     .rst_ni           ( rst_ni            ),
+    .testmode_i       ( testmode_i        ),
     .obi_req_i        ( pulser_obi_req    ),
     .obi_rsp_o        ( pulser_obi_rsp    ),
-    .pulse_o          ( pulse_o           )
+    .trig_event_i     ( adv_timer0_irqs   ),
+    .trig_gpio_i      ( gpio_in_sync_o    ),
+    .pulse_o          ( pulse_o           ),
+    .irq_o            ( pulser_irq        )
   );
 
   // adv_timer Subordinate
-  reg_req_t adv_timer_reg_req;
-  reg_rsp_t adv_timer_reg_rsp;
-
-  periph_to_reg #(
-    .AW    ( SbrObiCfg.AddrWidth  ),
-    .DW    ( SbrObiCfg.DataWidth  ),
-    .BW    ( 8                    ),
-    .IW    ( SbrObiCfg.IdWidth    ),
-    .req_t ( reg_req_t            ),
-    .rsp_t ( reg_rsp_t            )
-  ) i_adv_timer_translate (
-    .clk_i     ( clk_i                      ),
-    .rst_ni    ( rst_ni                     ),
-
-    .req_i     ( adv_timer_obi_req.req      ),
-    .add_i     ( adv_timer_obi_req.a.addr   ),
-    .wen_i     ( ~adv_timer_obi_req.a.we    ),
-    .wdata_i   ( adv_timer_obi_req.a.wdata  ),
-    .be_i      ( adv_timer_obi_req.a.be     ),
-    .id_i      ( adv_timer_obi_req.a.aid    ),
-
-    .gnt_o     ( adv_timer_obi_rsp.gnt      ),
-    .r_rdata_o ( adv_timer_obi_rsp.r.rdata  ),
-    .r_opc_o   ( adv_timer_obi_rsp.r.err    ),
-    .r_id_o    ( adv_timer_obi_rsp.r.rid    ),
-    .r_valid_o ( adv_timer_obi_rsp.rvalid   ),
-
-    .reg_req_o ( adv_timer_reg_req          ),
-    .reg_rsp_i ( adv_timer_reg_rsp          )
-  );
-
-  // Set unused wire to avoid any "Wire has no driver" warnings
-  assign adv_timer_obi_rsp.r.r_optional = 1'b0;
-
-
-  reg_adv_timer_wrap #(
-    .AddrWidth        ( 32          ),
-    .reg_req_t        ( reg_req_t   ),
-    .reg_rsp_t        ( reg_rsp_t   )
+  adv_timer_wrap #(
+    .ObiCfg           ( SbrObiCfg         ),
+    .obi_req_t        ( sbr_obi_req_t     ),
+    .obi_rsp_t        ( sbr_obi_rsp_t     ),
+    .ExtSigNum        ( GpioCount         ),
+    .CaptureDepth     ( AdvTimerCaptureDepth )
   ) i_adv_timer_wrap (
     .clk_i            ( clk_i             ),
     .rst_ni           ( rst_ni            ),
+    .testmode_i       ( testmode_i        ),
 
-    .reg_req_i        ( adv_timer_reg_req ),
-    .reg_rsp_o        ( adv_timer_reg_rsp ),
+    .obi_req_i        ( adv_timer_obi_req ),
+    .obi_rsp_o        ( adv_timer_obi_rsp ),
 
     .dft_cg_enable_i  ( 1'b0              ),
     .low_speed_clk_i  ( ref_clk_i         ),
     .ext_sig_i        ( gpio_i            ),
+    .cap_sig_i        ( gpio_in_sync_o    ),
+    .cap_irq_o        ( adv_timer_cap_irq ),
     .events_o         ( adv_timer0_irqs   ),
     .ch_0_o           ( ch_0_o            ),
     .ch_1_o           ( ch_1_o            ),
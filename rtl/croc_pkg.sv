@@ -40,6 +40,34 @@ package croc_pkg;
   localparam int unsigned NumExternalIrqs = 4;
 
 
+  ////////////////////////////
+  // Core Configuration    ///
+  ////////////////////////////
+  // Set at build time through defines, see CROC_DEFINES in the top-level Makefile
+
+  // Number of cve2 event counters (mhpmcounter3 and up, max 10), 0 removes them
+`ifdef CROC_HPM_COUNTERS
+  localparam int unsigned HpmCounterNum   = `CROC_HPM_COUNTERS;
+`else
+  localparam int unsigned HpmCounterNum   = 0;
+`endif
+  localparam int unsigned HpmCounterWidth = 40;
+
+  // cve2 multiply/divide unit: 0 none (RV32I), 1 slow (multi-cycle), 2 fast, 3 single-cycle mul
+`ifdef CROC_RV32M
+  localparam cve2_pkg::rv32m_e Rv32M = cve2_pkg::rv32m_e'(`CROC_RV32M);
+`else
+  localparam cve2_pkg::rv32m_e Rv32M = cve2_pkg::RV32MNone;
+`endif
+
+  // cve2 bit manipulation: 0 none, 1 balanced (Zba/Zbb/Zbs and more), 2 OpenTitan/EarlGrey, 3 full
+`ifdef CROC_RV32B
+  localparam cve2_pkg::rv32b_e Rv32B = cve2_pkg::rv32b_e'(`CROC_RV32B);
+`else
+  localparam cve2_pkg::rv32b_e Rv32B = cve2_pkg::RV32BNone;
+`endif
+
+
   ///////////////////////
   // Address Maps     ///
   ///////////////////////
@@ -66,6 +94,15 @@ package croc_pkg;
   localparam int unsigned SramBankAddrWidth = cf_math_pkg::idx_width(SramBankNumWords);
   localparam int unsigned SramAddrRange     = NumSramBanks*SramBankNumWords*4;
 
+  // SramInterleave stripes consecutive words across the banks instead of giving every bank
+  // one contiguous range (NumSramBanks must be a power of two), set through CROC_SRAM_INTERLEAVE
+`ifdef CROC_SRAM_INTERLEAVE
+  localparam bit          SramInterleave    = `CROC_SRAM_INTERLEAVE;
+`else
+  localparam bit          SramInterleave    = 1'b0;
+`endif
+  localparam int unsigned SramBankSelWidth  = cf_math_pkg::idx_width(NumSramBanks);
+
   localparam bit [31:0]   UserBaseAddr      = 32'h2000_0000;
   localparam bit [31:0]   UserAddrRange     = 32'h6000_0000;
 
@@ -104,6 +141,19 @@ package croc_pkg;
 
   localparam addr_map_rule_t [NumXbarSbrRules-1:0] croc_addr_map = gen_xbar_addr_rules();
 
+  // Map a manager address to the contiguous bank layout of the xbar rules and the banks.
+  // With SramInterleave the bank is selected by the lowest word address bits instead.
+  function automatic logic [31:0] sram_addr_remap(logic [31:0] addr);
+    logic [31:0] offs;
+    if (!SramInterleave || addr < SramBaseAddr || addr >= SramBaseAddr + SramAddrRange)
+      return addr;
+    offs = addr - SramBaseAddr;
+    return SramBaseAddr
+         + offs[2 +: SramBankSelWidth] * SramBankNumWords*4  // bank
+         + ((offs >> (2 + SramBankSelWidth)) << 2)            // word inside the bank
+         + offs[1:0];
+  endfunction
+
 
   /////////////////////////////
   // Peripheral address map ///
@@ -130,6 +180,12 @@ package croc_pkg;
   localparam bit [31:0] AdvTimerAddrOffset  = 32'h0300_E000;
   localparam bit [31:0] AdvTimerAddrRange   = 32'h0000_1000;
 
+  // Configuration entries queued per pulser instance (pulser_wrap)
+  localparam int unsigned PulserQueueDepth  = 2;
+
+  // Timestamps in the capture FIFO of the adv timer (adv_timer_wrap)
+  localparam int unsigned AdvTimerCaptureDepth = 8;
+
   localparam int unsigned NumPeriphRules  = 7;
   localparam int unsigned NumPeriphs      = NumPeriphRules + 1; // additional OBI error
 
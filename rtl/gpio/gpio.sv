@@ -40,6 +40,8 @@ module gpio #(
     /// GPIO interrupt line. The interrupt line is asserted for one clk_i
     /// whenever an unmasked interrupt on one of the GPIOs arrives.
     output logic                 interrupt_o,
+    /// Pattern stream low watermark interrupt (see gpio_stream).
+    output logic                 stream_irq_o,
 
     /// Control interface from interconnect (request).
     input  obi_req_t             obi_req_i,
@@ -66,6 +68,30 @@ module gpio #(
 
   logic gpio_intrpt_pending;
 
+  // Pattern stream
+  logic [GpioCount-1:0] stream_mask;
+  logic [GpioCount-1:0] stream_out;
+
+  // Split the bus: 0x000-0x3FF register file, 0x400 and above pattern stream
+  obi_req_t reg_obi_req, stream_obi_req;
+  obi_rsp_t reg_obi_rsp, stream_obi_rsp;
+
+  obi_demux #(
+    .ObiCfg      ( ObiCfg    ),
+    .obi_req_t   ( obi_req_t ),
+    .obi_rsp_t   ( obi_rsp_t ),
+    .NumMgrPorts ( 2         ),
+    .NumMaxTrans ( 2         )
+  ) i_obi_demux (
+    .clk_i,
+    .rst_ni,
+    .sbr_port_select_i ( obi_req_i.a.addr[10]           ),
+    .sbr_port_req_i    ( obi_req_i                      ),
+    .sbr_port_rsp_o    ( obi_rsp_o                      ),
+    .mgr_ports_req_o   ( {stream_obi_req, reg_obi_req}  ),
+    .mgr_ports_rsp_i   ( {stream_obi_rsp, reg_obi_rsp}  )
+  );
+
   // Instantiate register file
   gpio_reg_top #(
     .obi_req_t(obi_req_t),
@@ -74,12 +100,27 @@ module gpio #(
   ) i_reg_file (
     .clk_i,
     .rst_ni,
-    .obi_req_i,
-    .obi_rsp_o,
+    .obi_req_i(reg_obi_req),
+    .obi_rsp_o(reg_obi_rsp),
     .reg2hw(reg2hw),
     .hw2reg(hw2reg)
   );
 
+  gpio_stream #(
+    .ObiCfg    ( ObiCfg    ),
+    .obi_req_t ( obi_req_t ),
+    .obi_rsp_t ( obi_rsp_t ),
+    .GpioCount ( GpioCount )
+  ) i_stream (
+    .clk_i,
+    .rst_ni,
+    .obi_req_i ( stream_obi_req ),
+    .obi_rsp_o ( stream_obi_rsp ),
+    .mask_o    ( stream_mask    ),
+    .out_o     ( stream_out     ),
+    .irq_o     ( stream_irq_o   )
+  );
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   // Internal GPIO Logic - HW //
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -125,8 +166,8 @@ module gpio #(
         // Assign GPIO_IN register
         assign hw2reg[idx].sync_in = gpio_in_sync[idx] & is_input;
 
-        // Control output with GPIO_OUT register
-        assign gpio_o[idx] = reg2hw[idx].out & is_output;
+        // Control output with GPIO_OUT register or the pattern stream
+        assign gpio_o[idx] = (stream_mask[idx] ? stream_out[idx] : reg2hw[idx].out) & is_output;
 
         // Control gpio_out_en_o depending on GPIO_DIR register value
         assign gpio_out_en_o[idx] = is_output;
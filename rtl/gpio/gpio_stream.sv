@@ -0,0 +1,181 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Authors:
+// - Nico Canzani <ncanzani@student.ethz.ch>
+
+`include "common_cells/registers.svh"
+
+// GPIO pattern stream
+// Plays words from a FIFO out on the GPIOs selected in STREAM_MASK, one word every DIV+1 clock
+// cycles, so parallel patterns change at a fixed rate independent of the CPU. The rate is set
+// by a clock enable in the clk_i domain (no divided clock, no CDC towards the FIFO). The last
+// word is held when the FIFO runs empty while playing, which sets the underrun flag.
+//
+// Registers (offsets from the GPIO base address):
+// 0x400 STREAM_CTRL   [0] play, [1] irq enable, [15:8] low watermark
+// 0x404 STREAM_DIV    [15:0] output period in clock cycles minus one
+// 0x408 STREAM_MASK   GPIOs driven by the stream (they still need EN and DIR set)
+// 0x40C STREAM_STATUS [7:0] queued words, [8] underrun, [9] overflow (both write 1 to clear)
+// 0x410 STREAM_DATA   write: queue a word, dropped (overflow) if the FIFO is full
+// irq_o is high while playing with irq enable set and at most the watermark of words queued.
+module gpio_stream #(
+  /// The OBI configuration of the subordinate port.
+  parameter obi_pkg::obi_cfg_t ObiCfg    = obi_pkg::ObiDefaultConfig,
+  /// The request struct.
+  parameter type               obi_req_t = logic,
+  /// The response struct.
+  parameter type               obi_rsp_t = logic,
+  /// The number of GPIOs.
+  parameter int unsigned       GpioCount = 16,
+  /// Words in the FIFO (max 255).
+  parameter int unsigned       Depth     = 8
+) (
+  input  logic                 clk_i,
+  input  logic                 rst_ni,
+
+  input  obi_req_t             obi_req_i,
+  output obi_rsp_t             obi_rsp_o,
+
+  /// GPIOs driven by the stream
+  output logic [GpioCount-1:0] mask_o,
+  /// Current stream word
+  output logic [GpioCount-1:0] out_o,
+  /// Low watermark reached
+  output logic                 irq_o
+);
+
+  localparam logic [11:0] CtrlAddr   = 12'h400;
+  localparam logic [11:0] DivAddr    = 12'h404;
+  localparam logic [11:0] MaskAddr   = 12'h408;
+  localparam logic [11:0] StatusAddr = 12'h40C;
+  localparam logic [11:0] DataAddr   = 12'h410;
+
+  typedef logic [GpioCount-1:0] word_t;
+
+  logic [11:0] addr;
+  assign addr = obi_req_i.a.addr[11:0];
+
+  // ---------
+  // Registers
+  // ---------
+  logic        play_d, play_q, irq_en_d, irq_en_q;
+  logic [ 7:0] watermark_d, watermark_q;
+  logic [15:0] div_d, div_q;
+  word_t       mask_d, mask_q;
+  logic        underrun_d, underrun_q, overflow_d, overflow_q;
+
+  logic        push, pop, full, empty;
+  logic [cf_math_pkg::idx_width(Depth)-1:0] usage;
+  logic [ 7:0] level;
+  word_t       head;
+  logic        tick;
+
+  // subordinate response, one cycle after the request
+  logic                        rsp_valid_d, rsp_valid_q;
+  logic [ObiCfg.IdWidth-1:0]   rsp_id_d, rsp_id_q;
+  logic [ObiCfg.DataWidth-1:0] rsp_data_d, rsp_data_q;
+
+  assign level = full ? 8'(Depth) : 8'(usage);
+
+  always_comb begin
+    play_d      = play_q;
+    irq_en_d    = irq_en_q;
+    watermark_d = watermark_q;
+    div_d       = div_q;
+    mask_d      = mask_q;
+    underrun_d  = underrun_q | (play_q & tick & empty);
+    overflow_d  = overflow_q;
+    push        = 1'b0;
+    rsp_data_d  = '0;
+
+    if (obi_req_i.req && obi_req_i.a.we) begin
+      unique case (addr)
+        CtrlAddr: begin
+          play_d      = obi_req_i.a.wdata[0];
+          irq_en_d    = obi_req_i.a.wdata[1];
+          watermark_d = obi_req_i.a.wdata[15:8];
+        end
+        DivAddr:  div_d  = obi_req_i.a.wdata[15:0];
+        MaskAddr: mask_d = obi_req_i.a.wdata[GpioCount-1:0];
+        StatusAddr: begin
+          if (obi_req_i.a.wdata[8]) underrun_d = 1'b0;
+          if (obi_req_i.a.wdata[9]) overflow_d = 1'b0;
+        end
+        DataAddr: begin
+          push       = ~full;
+          overflow_d = overflow_q | full;
+        end
+        default: ;
+      endcase
+    end else if (obi_req_i.req) begin
+      unique case (addr)
+        CtrlAddr:   rsp_data_d = {16'b0, watermark_q, 6'b0, irq_en_q, play_q};
+        DivAddr:    rsp_data_d = {16'b0, div_q};
+        MaskAddr:   rsp_data_d = 32'(mask_q);
+        StatusAddr: rsp_data_d = {22'b0, overflow_q, underrun_q, level};
+        default: ;
+      endcase
+    end
+  end
+
+  assign rsp_valid_d = obi_req_i.req;
+  assign rsp_id_d    = obi_req_i.a.aid;
+
+  `FF(play_q,      play_d,      '0)
+  `FF(irq_en_q,    irq_en_d,    '0)
+  `FF(watermark_q, watermark_d, '0)
+  `FF(div_q,       div_d,       '0)
+  `FF(mask_q,      mask_d,      '0)
+  `FF(underrun_q,  underrun_d,  '0)
+  `FF(overflow_q,  overflow_d,  '0)
+  `FF(rsp_valid_q, rsp_valid_d, '0)
+  `FF(rsp_id_q,    rsp_id_d,    '0)
+  `FF(rsp_data_q,  rsp_data_d,  '0)
+
+  assign obi_rsp_o.gnt          = obi_req_i.req;
+  assign obi_rsp_o.rvalid       = rsp_valid_q;
+  assign obi_rsp_o.r.rdata      = rsp_data_q;
+  assign obi_rsp_o.r.rid        = rsp_id_q;
+  assign obi_rsp_o.r.err        = 1'b0;
+  assign obi_rsp_o.r.r_optional = '0;
+
+  // --------
+  // Playback
+  // --------
+  // tick every div_q+1 cycles while playing, the first one right after play is set
+  logic [15:0] cnt_d, cnt_q;
+  word_t       out_d, out_q;
+
+  assign tick  = play_q & (cnt_q == '0);
+  assign cnt_d = !play_q ? '0 : (tick ? div_q : cnt_q - 16'd1);
+  assign pop   = tick & ~empty;
+  assign out_d = pop ? head : out_q;
+
+  `FF(cnt_q, cnt_d, '0)
+  `FF(out_q, out_d, '0)
+
+  fifo_v3 #(
+    .FALL_THROUGH ( 1'b0   ),
+    .DEPTH        ( Depth  ),
+    .dtype        ( word_t )
+  ) i_fifo (
+    .clk_i,
+    .rst_ni,
+    .flush_i    ( 1'b0                             ),
+    .testmode_i ( 1'b0                             ),
+    .full_o     ( full                             ),
+    .empty_o    ( empty                            ),
+    .usage_o    ( usage                            ),
+    .data_i     ( obi_req_i.a.wdata[GpioCount-1:0] ),
+    .push_i     ( push                             ),
+    .data_o     ( head                             ),
+    .pop_i      ( pop                              )
+  );
+
+  assign mask_o = mask_q;
+  assign out_o  = out_q;
+  assign irq_o  = play_q & irq_en_q & (level <= watermark_q);
+
+endmodule
@@ -0,0 +1,575 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Authors:
+// - Nico Canzani <ncanzani@student.ethz.ch>
+
+// gives us the `FF(...) macro making it easy to have properly defined flip-flops
+`include "common_cells/registers.svh"
+
+// Pulser with a per-instance configuration queue
+// The pulser registers (core 0x000-0x0FF, general 0x100-0x107) are passed through unchanged.
+// The wrapper adds a configuration queue per instance: an entry (F1, F2, CNT, CTRL_OUT) is
+// loaded and started by a small sequencer as soon as the instance is IDLE or DONE, so trains
+// follow each other without the CPU. The sequencer shares the pulser bus with the CPU and the
+// trigger crossbar (fixed priority: trigger, sequencer, CPU) and only polls the status of instances with queued entries or a running train.
+// The gap between two queued trains is not fixed: after DONE the sequencer may first poll every
+// other instance with a queued entry or a running train (one status read each, round robin),
+// then it reads the status and writes F1, F2, CNT, CTRL_OUT and START. Each of these
+// transactions can also wait for a trigger write, and for a CPU transaction already in flight.
+// Flushing the queue while its entry is written aborts the sequence before START, the instance
+// then keeps the words written so far but is not started.
+// A running train that reads DONE sets the instance in IRQ_PENDING, raising irq_o if unmasked.
+// This requires DONE to be held until the instance is started again.
+//
+// Interrupt registers, next to the general registers:
+// 0x108 IRQ_PENDING read: instances that completed a train, write 1 to clear
+// 0x10C IRQ_MASK    read/write: instances that raise irq_o
+//
+// Queue registers (offsets from the pulser base address):
+// 0x200 Q_F1, 0x204 Q_F2, 0x208 Q_CNT, 0x20C Q_CTRL_OUT  staging entry, same layout as the core
+// 0x210 Q_PUSH      write: push the staging entry to the queues of all instances set in the mask
+// 0x214 Q_FLUSH     write: drop the queued entries of all instances set in the mask
+// 0x218 Q_FULL      read: mask of full queues
+// 0x21C Q_EMPTY     read: mask of empty queues
+// 0x220 + 4*id      Q_LEVEL[id], read: number of queued entries
+//
+// Trigger crossbar: rising edges of the trigger sources start/stop any subset of instances,
+// written to the general CTRL register by a bus port with the highest priority towards the
+// pulser. The write is granted the next time the pulser accepts a request, which only waits if
+// a CPU or sequencer request is already presented to the pulser and not yet granted.
+// Sources 0..NumTrigEvents-1 are the trig_event_i lines (adv timer events), the last two are
+// GPIO edges. Writing TRIG_GPIO does not fire a GPIO source, the edge detection starts with the
+// level of the newly selected pin.
+// 0x300 + 4*src     TRIG_ROUTE[src]: [15:0] instances to start, [31:16] instances to stop
+// 0x320 TRIG_GPIO   per GPIO source k (byte k): [4:0] pin, [5] rising edge, [6] falling edge
+module pulser_wrap #(
+  /// The OBI configuration for all ports.
+  parameter obi_pkg::obi_cfg_t ObiCfg        = obi_pkg::ObiDefaultConfig,
+  /// The request struct.
+  parameter type               obi_req_t     = logic,
+  /// The response struct.
+  parameter type               obi_rsp_t     = logic,
+  /// The A channel struct.
+  parameter type               obi_a_chan_t  = logic,
+  /// The R channel struct.
+  parameter type               obi_r_chan_t  = logic,
+  /// The register interface request struct (pulser internal).
+  parameter type               reg_req_t     = logic,
+  /// The register interface response struct (pulser internal).
+  parameter type               reg_rsp_t     = logic,
+  /// Number of pulser instances (max 16).
+  parameter int unsigned       N_PULSER_INST = 4,
+  /// Queued entries per instance.
+  parameter int unsigned       QueueDepth    = 2,
+  /// Base address of the pulser, used by the sequencer.
+  parameter logic [31:0]       BaseAddr      = '0,
+  /// Number of event trigger inputs.
+  parameter int unsigned       NumTrigEvents = 4,
+  /// Number of GPIOs available as trigger sources.
+  parameter int unsigned       GpioCount     = 32
+) (
+  input  logic                     clk_i,
+  input  logic                     rst_ni,
+  input  logic                     testmode_i,
+
+  input  obi_req_t                 obi_req_i,
+  output obi_rsp_t                 obi_rsp_o,
+
+  /// Trigger sources: timer events and synchronized GPIO inputs
+  input  logic [NumTrigEvents-1:0] trig_event_i,
+  input  logic [GpioCount-1:0]     trig_gpio_i,
+
+  output logic [N_PULSER_INST-1:0] pulse_o,
+  /// A train completed on an instance set in IRQ_PENDING and IRQ_MASK
+  output logic                     irq_o
+);
+
+  // pulser register map
+  localparam logic [11:0] CoreOffsetPerId   = 12'h020;
+  localparam logic [11:0] CoreCfgF1Offset   = 12'h000;
+  localparam logic [11:0] CoreCfgF2Offset   = 12'h004;
+  localparam logic [11:0] CoreCfgCntOffset  = 12'h008;
+  localparam logic [11:0] CoreStatusOffset  = 12'h00C;
+  localparam logic [11:0] CoreCtrlOutOffset = 12'h010;
+  localparam logic [11:0] GeneralCtrlAddr   = 12'h100;
+  localparam logic [11:0] WrapRegOffset     = 12'h108; // first address handled by the wrapper
+
+  // interrupt register map
+  localparam logic [11:0] IrqPendingAddr   = 12'h108;
+  localparam logic [11:0] IrqMaskAddr      = 12'h10C;
+
+  // queue register map
+  localparam logic [11:0] QueueStageAddr   = 12'h200; // 4 words
+  localparam logic [11:0] QueuePushAddr    = 12'h210;
+  localparam logic [11:0] QueueFlushAddr   = 12'h214;
+  localparam logic [11:0] QueueFullAddr    = 12'h218;
+  localparam logic [11:0] QueueEmptyAddr   = 12'h21C;
+  localparam logic [11:0] QueueLevelAddr   = 12'h220;
+
+  // trigger register map
+  localparam logic [11:0] TrigRouteAddr    = 12'h300; // one word per source
+  localparam logic [11:0] TrigGpioAddr     = 12'h320;
+
+  localparam int unsigned NumTrigGpio      = 2;
+  localparam int unsigned NumTrigSrc       = NumTrigEvents + NumTrigGpio;
+
+  localparam int unsigned NumCfgWords = 4; // CFG_F1, CFG_F2, CFG_CNT, CTRL_OUT
+  // core register of each word, STATUS sits between CFG_CNT and CTRL_OUT
+  localparam logic [NumCfgWords-1:0][11:0] CoreCfgWordOffset =
+      {CoreCtrlOutOffset, CoreCfgCntOffset, CoreCfgF2Offset, CoreCfgF1Offset};
+
+  // pulser core status
+  localparam logic [2:0] StateIdle = 3'd0;
+  localparam logic [2:0] StateDone = 3'd4;
+
+  typedef logic [NumCfgWords-1:0][31:0] cfg_entry_t;
+
+  typedef enum logic [2:0] {
+    SeqIdle,
+    SeqPollReq,
+    SeqPollRsp,
+    SeqWriteReq,
+    SeqWriteRsp
+  } seq_state_e;
+
+  // ---------------------
+  // Bus split and merge
+  // ---------------------
+  // CPU -> {pulser, wrapper registers}, {CPU, sequencer, trigger} -> pulser
+  obi_req_t cpu_pulser_req, wrap_req, seq_req, trig_req, pulser_req;
+  obi_rsp_t cpu_pulser_rsp, wrap_rsp, seq_rsp, trig_rsp, pulser_rsp;
+
+  logic wrap_sel;
+  assign wrap_sel = (obi_req_i.a.addr[11:0] >= WrapRegOffset);
+
+  obi_demux #(
+    .ObiCfg      ( ObiCfg    ),
+    .obi_req_t   ( obi_req_t ),
+    .obi_rsp_t   ( obi_rsp_t ),
+    .NumMgrPorts ( 2         ),
+    .NumMaxTrans ( 2         )
+  ) i_obi_demux (
+    .clk_i,
+    .rst_ni,
+
+    .sbr_port_select_i ( wrap_sel  ),
+    .sbr_port_req_i    ( obi_req_i ),
+    .sbr_port_rsp_o    ( obi_rsp_o ),
+
+    .mgr_ports_req_o   ( {wrap_req, cpu_pulser_req} ),
+    .mgr_ports_rsp_i   ( {wrap_rsp, cpu_pulser_rsp} )
+  );
+
+  // Fixed priority towards the pulser, port 0 first: trigger, sequencer, CPU. The selected port
+  // is held while its request waits for the grant. Responses come back in order, the port of each
+  // granted request is kept in a FIFO.
+  localparam int unsigned NumPulserPorts = 3;
+
+  obi_req_t [NumPulserPorts-1:0] port_req;
+  obi_rsp_t [NumPulserPorts-1:0] port_rsp;
+  logic [1:0] port_sel, port_lock_d, port_lock_q, rsp_port;
+  logic       port_valid, port_locked_d, port_locked_q, rsp_fifo_full;
+
+  assign port_req = {cpu_pulser_req, seq_req, trig_req};
+  assign {cpu_pulser_rsp, seq_rsp, trig_rsp} = port_rsp;
+
+  always_comb begin
+    port_sel   = '0;
+    port_valid = 1'b0;
+    for (int unsigned i = 0; i < NumPulserPorts; i++) begin
+      if (!port_valid && port_req[i].req) begin
+        port_sel   = 2'(i);
+        port_valid = 1'b1;
+      end
+    end
+    if (port_locked_q) begin
+      port_sel   = port_lock_q;
+      port_valid = 1'b1;
+    end
+
+    pulser_req     = port_req[port_sel];
+    pulser_req.req = port_valid & ~rsp_fifo_full;
+    if (ObiCfg.UseRReady) pulser_req.rready = port_req[rsp_port].rready;
+
+    for (int unsigned i = 0; i < NumPulserPorts; i++) begin
+      port_rsp[i]        = pulser_rsp;
+      port_rsp[i].gnt    = pulser_rsp.gnt & pulser_req.req & (port_sel == i);
+      port_rsp[i].rvalid = pulser_rsp.rvalid & (rsp_port == i);
+    end
+
+    port_locked_d = pulser_req.req & ~pulser_rsp.gnt;
+    port_lock_d   = port_sel;
+  end
+
+  `FF(port_locked_q, port_locked_d, '0)
+  `FF(port_lock_q,   port_lock_d,   '0)
+
+  fifo_v3 #(
+    .FALL_THROUGH ( 1'b0 ),
+    .DATA_WIDTH   ( 2    ),
+    .DEPTH        ( 2    )
+  ) i_rsp_fifo (
+    .clk_i,
+    .rst_ni,
+    .flush_i    ( 1'b0                              ),
+    .testmode_i,
+    .full_o     ( rsp_fifo_full                     ),
+    .empty_o    (                                   ),
+    .usage_o    (                                   ),
+    .data_i     ( port_sel                          ),
+    .push_i     ( pulser_req.req & pulser_rsp.gnt   ),
+    .data_o     ( rsp_port                          ),
+    .pop_i      ( pulser_rsp.rvalid                 )
+  );
+
+  pulser #(
+    .ObiCfg           ( ObiCfg        ),
+    .obi_req_t        ( obi_req_t     ),
+    .obi_rsp_t        ( obi_rsp_t     ),
+    .reg_req_t        ( reg_req_t     ),
+    .reg_rsp_t        ( reg_rsp_t     ),
+    .N_PULSER_INST    ( N_PULSER_INST )
+  ) i_pulser (
+    .clk_i            ( clk_i         ),
+    .rst_ni           ( rst_ni        ),
+    .obi_req_i        ( pulser_req    ),
+    .obi_rsp_o        ( pulser_rsp    ),
+    .pulse_o          ( pulse_o       )
+  );
+
+  // ------------------
+  // Wrapper registers
+  // ------------------
+  cfg_entry_t stage_d, stage_q;
+  logic [N_PULSER_INST-1:0] irq_pending_d, irq_pending_q, irq_pending_clr, irq_mask_d, irq_mask_q;
+  logic [NumTrigSrc-1:0][31:0] trig_route_d, trig_route_q;
+  logic [NumTrigGpio-1:0][6:0] trig_gpio_cfg_d, trig_gpio_cfg_q;
+  logic [N_PULSER_INST-1:0] q_push, q_flush, q_pop, q_full, q_empty;
+  logic [N_PULSER_INST-1:0][$clog2(QueueDepth+1)-1:0] q_level;
+  cfg_entry_t [N_PULSER_INST-1:0] q_head;
+
+  logic                         rsp_valid_d, rsp_valid_q;
+  logic [ObiCfg.IdWidth-1:0]    rsp_id_d, rsp_id_q;
+  logic [ObiCfg.DataWidth-1:0]  rsp_data_d, rsp_data_q;
+
+  logic [11:0] wrap_addr;
+  assign wrap_addr = {wrap_req.a.addr[11:2], 2'b00};
+
+  always_comb begin
+    stage_d         = stage_q;
+    q_push          = '0;
+    q_flush         = '0;
+    irq_pending_clr = '0;
+    irq_mask_d      = irq_mask_q;
+    trig_route_d    = trig_route_q;
+    trig_gpio_cfg_d = trig_gpio_cfg_q;
+    rsp_data_d      = '0;
+
+    if (wrap_req.req && wrap_req.a.we) begin
+      if (wrap_addr == IrqPendingAddr)
+        irq_pending_clr = wrap_req.a.wdata[N_PULSER_INST-1:0];
+      if (wrap_addr == IrqMaskAddr)
+        irq_mask_d      = wrap_req.a.wdata[N_PULSER_INST-1:0];
+      for (int unsigned k = 0; k < NumTrigSrc; k++) begin
+        if (wrap_addr == TrigRouteAddr + 4*k)
+          trig_route_d[k] = wrap_req.a.wdata;
+      end
+      if (wrap_addr == TrigGpioAddr) begin
+        for (int unsigned k = 0; k < NumTrigGpio; k++)
+          trig_gpio_cfg_d[k] = wrap_req.a.wdata[8*k +: 7];
+      end
+      if (wrap_addr >= QueueStageAddr && wrap_addr < QueueStageAddr + 4*NumCfgWords)
+        stage_d[wrap_addr[3:2]] = wrap_req.a.wdata;
+      if (wrap_addr == QueuePushAddr)
+        q_push  = wrap_req.a.wdata[N_PULSER_INST-1:0] & ~q_full;
+      if (wrap_addr == QueueFlushAddr)
+        q_flush = wrap_req.a.wdata[N_PULSER_INST-1:0];
+    end else if (wrap_req.req) begin
+      if (wrap_addr == IrqPendingAddr)
+        rsp_data_d = 32'(irq_pending_q);
+      if (wrap_addr == IrqMaskAddr)
+        rsp_data_d = 32'(irq_mask_q);
+      for (int unsigned k = 0; k < NumTrigSrc; k++) begin
+        if (wrap_addr == TrigRouteAddr + 4*k)
+          rsp_data_d = trig_route_q[k];
+      end
+      if (wrap_addr == TrigGpioAddr) begin
+        for (int unsigned k = 0; k < NumTrigGpio; k++)
+          rsp_data_d[8*k +: 7] = trig_gpio_cfg_q[k];
+      end
+      if (wrap_addr >= QueueStageAddr && wrap_addr < QueueStageAddr + 4*NumCfgWords)
+        rsp_data_d = stage_q[wrap_addr[3:2]];
+      if (wrap_addr == QueueFullAddr)
+        rsp_data_d = 32'(q_full);
+      if (wrap_addr == QueueEmptyAddr)
+        rsp_data_d = 32'(q_empty);
+      for (int unsigned i = 0; i < N_PULSER_INST; i++) begin
+        if (wrap_addr == QueueLevelAddr + 4*i)
+          rsp_data_d = 32'(q_level[i]);
+      end
+    end
+  end
+
+  assign rsp_valid_d = wrap_req.req;
+  assign rsp_id_d    = wrap_req.a.aid;
+
+  `FF(stage_q,     stage_d,     '0)
+  `FF(irq_mask_q,  irq_mask_d,  '0)
+  `FF(trig_route_q,    trig_route_d,    '0)
+  `FF(trig_gpio_cfg_q, trig_gpio_cfg_d, '0)
+  `FF(rsp_valid_q, rsp_valid_d, '0)
+  `FF(rsp_id_q,    rsp_id_d,    '0)
+  `FF(rsp_data_q,  rsp_data_d,  '0)
+
+  assign wrap_rsp.gnt          = wrap_req.req;
+  assign wrap_rsp.rvalid       = rsp_valid_q;
+  assign wrap_rsp.r.rdata      = rsp_data_q;
+  assign wrap_rsp.r.rid        = rsp_id_q;
+  assign wrap_rsp.r.err        = 1'b0;
+  assign wrap_rsp.r.r_optional = '0;
+
+  // ------------------------
+  // Configuration queues
+  // ------------------------
+  for (genvar i = 0; i < N_PULSER_INST; i++) begin : gen_queue
+    logic [cf_math_pkg::idx_width(QueueDepth)-1:0] usage;
+
+    fifo_v3 #(
+      .FALL_THROUGH ( 1'b0        ),
+      .DEPTH        ( QueueDepth  ),
+      .dtype        ( cfg_entry_t )
+    ) i_cfg_fifo (
+      .clk_i,
+      .rst_ni,
+      .flush_i    ( q_flush[i] ),
+      .testmode_i,
+      .full_o     ( q_full[i]  ),
+      .empty_o    ( q_empty[i] ),
+      .usage_o    ( usage      ),
+      .data_i     ( stage_q    ),
+      .push_i     ( q_push[i]  ),
+      .data_o     ( q_head[i]  ),
+      .pop_i      ( q_pop[i]   )
+    );
+
+    assign q_level[i] = q_full[i] ? QueueDepth : usage;
+  end
+
+  // -----------------
+  // Trigger crossbar
+  // -----------------
+  // Fired sources collect their start/stop masks, which are written to the general CTRL
+  // register in one transaction. Sources firing while that write waits are merged into it
+  // or into the next one.
+  logic [NumTrigEvents-1:0] trig_event_q;
+  logic [NumTrigGpio-1:0]   trig_gpio_q;
+  logic [NumTrigSrc-1:0]    trig_fire;
+  logic [N_PULSER_INST-1:0] trig_start_d, trig_start_q, trig_stop_d, trig_stop_q;
+  logic [N_PULSER_INST-1:0] trig_start, trig_stop; // sent to the pulser this cycle
+  logic                     trig_busy_d, trig_busy_q; // write granted, waiting for response
+
+  always_comb begin
+    trig_fire = '0;
+    trig_fire[NumTrigEvents-1:0] = trig_event_i & ~trig_event_q;
+    for (int unsigned k = 0; k < NumTrigGpio; k++) begin
+      automatic logic level = trig_gpio_i[trig_gpio_cfg_q[k][4:0]];
+      trig_fire[NumTrigEvents+k] = (trig_gpio_cfg_q[k][5] &  level & ~trig_gpio_q[k]) |
+                                   (trig_gpio_cfg_q[k][6] & ~level &  trig_gpio_q[k]);
+    end
+  end
+
+  // sampled from the pin selected next cycle, a TRIG_GPIO write must not look like an edge
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      trig_gpio_q <= '0;
+    end else begin
+      for (int unsigned k = 0; k < NumTrigGpio; k++)
+        trig_gpio_q[k] <= trig_gpio_i[trig_gpio_cfg_d[k][4:0]];
+    end
+  end
+
+  `FF(trig_event_q, trig_event_i, '0)
+
+  always_comb begin
+    trig_req             = '0;
+    trig_req.req         = ~trig_busy_q & (|trig_start_q | |trig_stop_q);
+    trig_req.a.we        = 1'b1;
+    trig_req.a.be        = '1;
+    trig_req.a.addr      = BaseAddr + GeneralCtrlAddr;
+    trig_req.a.wdata     = '0;
+    trig_req.a.wdata[N_PULSER_INST-1:0]     = trig_start_q;
+    trig_req.a.wdata[16 +: N_PULSER_INST]   = trig_stop_q;
+
+    trig_start  = '0;
+    trig_stop   = '0;
+    trig_busy_d = trig_busy_q;
+    if (trig_req.req && trig_rsp.gnt) begin
+      trig_start  = trig_start_q;
+      trig_stop   = trig_stop_q;
+      trig_busy_d = 1'b1;
+    end
+    if (trig_rsp.rvalid) trig_busy_d = 1'b0;
+
+    trig_start_d = trig_start_q & ~trig_start;
+    trig_stop_d  = trig_stop_q  & ~trig_stop;
+    for (int unsigned k = 0; k < NumTrigSrc; k++) begin
+      if (trig_fire[k]) begin
+        trig_start_d |= trig_route_q[k][N_PULSER_INST-1:0];
+        trig_stop_d  |= trig_route_q[k][16 +: N_PULSER_INST];
+      end
+    end
+  end
+
+  `FF(trig_start_q, trig_start_d, '0)
+  `FF(trig_stop_q,  trig_stop_d,  '0)
+  `FF(trig_busy_q,  trig_busy_d,  '0)
+
+  // ----------------------------
+  // Running trains and interrupt
+  // ----------------------------
+  // Starts and stops are seen on the bus (CPU and trigger writes to the general CTRL register and
+  // starts of the sequencer), the end of a train when the sequencer polls DONE (or IDLE after a
+  // stop).
+  logic [N_PULSER_INST-1:0] running_d, running_q;
+  logic [N_PULSER_INST-1:0] cpu_start, cpu_stop, seq_start, seq_done, seq_idle;
+
+  always_comb begin
+    cpu_start = '0;
+    cpu_stop  = '0;
+    if (cpu_pulser_req.req && cpu_pulser_rsp.gnt && cpu_pulser_req.a.we &&
+        cpu_pulser_req.a.addr[11:0] == GeneralCtrlAddr) begin
+      cpu_start = cpu_pulser_req.a.wdata[N_PULSER_INST-1:0];
+      cpu_stop  = cpu_pulser_req.a.wdata[16 +: N_PULSER_INST];
+    end
+  end
+
+  assign running_d     = (running_q & ~(seq_done | seq_idle | cpu_stop | trig_stop)) |
+                         cpu_start | seq_start | trig_start;
+  assign irq_pending_d = (irq_pending_q & ~irq_pending_clr) | seq_done;
+
+  `FF(running_q,     running_d,     '0)
+  `FF(irq_pending_q, irq_pending_d, '0)
+
+  assign irq_o = |(irq_pending_q & irq_mask_q);
+
+  // ----------
+  // Sequencer
+  // ----------
+  // Polls the status of instances with queued entries or running trains (round robin). When an
+  // instance is IDLE or DONE its next entry is written to CFG_F1..CTRL_OUT and it is started.
+  seq_state_e state_d, state_q;
+  logic [cf_math_pkg::idx_width(N_PULSER_INST)-1:0] inst_d, inst_q;
+  logic [$clog2(NumCfgWords+1)-1:0] word_d, word_q; // NumCfgWords: write the start command
+  logic [N_PULSER_INST-1:0] poll_mask;
+  logic [cf_math_pkg::idx_width(N_PULSER_INST)-1:0] next_inst;
+  logic next_valid;
+  logic [2:0] polled_state;
+  logic poll_stale_d, poll_stale_q; // started while the status read was in flight
+  logic seq_flushed_d, seq_flushed_q; // queue of inst_q flushed while its entry is written
+
+  assign poll_mask    = ~q_empty | running_q;
+  assign polled_state = seq_rsp.r.rdata[3:1];
+
+  // next instance to poll after inst_q
+  always_comb begin
+    next_inst  = inst_q;
+    next_valid = 1'b0;
+    for (int unsigned k = 1; k <= N_PULSER_INST; k++) begin
+      automatic int unsigned idx = (int'(inst_q) + k) % N_PULSER_INST;
+      if (!next_valid && poll_mask[idx]) begin
+        next_inst  = idx[$bits(next_inst)-1:0];
+        next_valid = 1'b1;
+      end
+    end
+  end
+
+  always_comb begin
+    state_d   = state_q;
+    inst_d    = inst_q;
+    word_d    = word_q;
+    q_pop     = '0;
+    seq_start = '0;
+    seq_done  = '0;
+    seq_idle  = '0;
+
+    poll_stale_d  = poll_stale_q | cpu_start[inst_q] | trig_start[inst_q];
+    seq_flushed_d = seq_flushed_q | q_flush[inst_q];
+
+    seq_req              = '0;
+    seq_req.a.be         = '1;
+    seq_req.a.addr       = BaseAddr + inst_q * CoreOffsetPerId + CoreStatusOffset;
+
+    unique case (state_q)
+      SeqIdle: begin
+        if (next_valid) begin
+          inst_d  = next_inst;
+          state_d = SeqPollReq;
+        end
+      end
+
+      SeqPollReq: begin
+        seq_req.req  = 1'b1;
+        poll_stale_d = 1'b0;
+        if (seq_rsp.gnt) state_d = SeqPollRsp;
+      end
+
+      SeqPollRsp: begin
+        if (seq_rsp.rvalid && !poll_stale_d && running_q[inst_q]) begin
+          seq_done[inst_q] = (polled_state == StateDone);
+          seq_idle[inst_q] = (polled_state == StateIdle);
+        end
+        if (seq_rsp.rvalid) begin
+          if (poll_stale_d) begin
+            state_d = SeqIdle;
+          end else if (!q_empty[inst_q] && !q_flush[inst_q] &&
+                       (polled_state == StateIdle || polled_state == StateDone)) begin
+            seq_flushed_d = 1'b0;
+            word_d        = '0;
+            state_d       = SeqWriteReq;
+          end else begin
+            state_d = SeqIdle;
+          end
+        end
+      end
+
+      SeqWriteReq: begin
+        seq_req.req        = 1'b1;
+        seq_req.a.we       = 1'b1;
+        if (word_q == NumCfgWords) begin
+          seq_req.a.addr  = BaseAddr + GeneralCtrlAddr;
+          seq_req.a.wdata = 32'(1) << inst_q; // START
+        end else begin
+          seq_req.a.addr  = BaseAddr + inst_q * CoreOffsetPerId + CoreCfgWordOffset[word_q];
+          seq_req.a.wdata = q_head[inst_q][word_q];
+        end
+        if (seq_rsp.gnt) state_d = SeqWriteRsp;
+      end
+
+      SeqWriteRsp: begin
+        if (seq_rsp.rvalid) begin
+          if (word_q == NumCfgWords) begin
+            q_pop[inst_q]     = ~q_empty[inst_q]; // unless flushed meanwhile
+            seq_start[inst_q] = 1'b1;
+            state_d           = SeqIdle;
+          end else if (seq_flushed_d) begin
+            state_d           = SeqIdle; // flushed, q_head is gone, do not write START
+          end else begin
+            word_d        = word_q + 1;
+            state_d       = SeqWriteReq;
+          end
+        end
+      end
+
+      default: state_d = SeqIdle;
+    endcase
+  end
+
+  `FF(state_q, state_d, SeqIdle)
+  `FF(inst_q,  inst_d,  '0)
+  `FF(poll_stale_q, poll_stale_d, '0)
+  `FF(seq_flushed_q, seq_flushed_d, '0)
+  `FF(word_q,  word_d,  '0)
+
+endmodule
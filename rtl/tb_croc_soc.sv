@@ -54,6 +54,7 @@ module tb_croc_soc #(
     //  Command Line Arguments //
     /////////////////////////////
     string binary_path;
+    bit    preload;
     initial begin
         if ($value$plusargs("binary=%s", binary_path)) begin
             $display("Running program: %s", binary_path);
@@ -61,6 +62,8 @@ module tb_croc_soc #(
             $display("No binary path provided. Running helloworld.");
             binary_path = "../sw/bin/helloworld.hex";
         end
+        // +preload: write the binary directly into the SRAM banks instead of loading it via JTAG
+        preload = $test$plusargs("preload");
     end
 
 
@@ -217,14 +220,16 @@ module tb_croc_soc #(
 
 
     // Load the binary formated as 32bit hex file
+    // The bytes are collected into words first, so sections that start or end on a 16-bit
+    // boundary (compressed code) are written completely.
     task jtag_load_hex(input string filename);
         int file;
         int status;
         string line;
         bit [31:0] addr;
-        bit [31:0] data;
+        bit [31:0] next_addr;
         bit [7:0] byte_data;
-        int byte_count;
+        bit [31:0] image [bit [31:0]]; // word address -> data
         static dm::sbcs_t sbcs = dm::sbcs_t'{sbautoincrement: 1'b1, sbaccess: 2, default: '0};
 
         file = $fopen(filename, "r");
@@ -235,7 +240,7 @@ module tb_croc_soc #(
         end
 
         $display("@%t | [JTAG] Loading binary from %s", $time, filename);
-        jtag_dbg.write_dmi(dm::SBCS, sbcs);
+        image.delete();
 
         // line by line
         while (!$feof(file)) begin
@@ -249,14 +254,9 @@ module tb_croc_soc #(
                 if (status != 1) begin
                     $fatal(1, "Error: Incorrect address line format in file %s", filename);
                 end
-                $display("@%t | [JTAG] Writing to memory @%08x ", $time, addr);
-                jtag_dbg.write_dmi(dm::SBAddress0, addr);
                 continue;
             end
 
-            byte_count = 0;
-            data = 32'h0;
-
             // Loop through the line to read bytes
             while (line.len() > 0) begin
                 status = $sscanf(line, "%h", byte_data); // Extract one byte
@@ -264,24 +264,29 @@ module tb_croc_soc #(
                     break; // No more data to read on this line
                 end
 
-                // Shift in the byte to the correct position in the data word
-                data = {byte_data, data[31:8]}; // Combine bytes into a 32-bit word
-                byte_count++;
+                // Place the byte in its word
+                if (!image.exists({addr[31:2], 2'b00})) image[{addr[31:2], 2'b00}] = 32'h0;
+                image[{addr[31:2], 2'b00}][8*addr[1:0] +: 8] = byte_data;
+                addr += 1;
 
                 // remove the byte from the line (2 numbers + 1 space)
                 line = line.substr(3, line.len()-1);
+            end
+        end
+        $fclose(file);
 
-                // write a complete word via jtag
-                if (byte_count == 4) begin
-                    jtag_write(dm::SBData0, data);
-                    addr += 4;
-                    data = 32'h0;
-                    byte_count = 0;
-                end
+        // write the words in address order, contiguous runs use the address auto-increment
+        jtag_dbg.write_dmi(dm::SBCS, sbcs);
+        next_addr = 32'h0;
+        foreach (image[word_addr]) begin
+            if (word_addr != next_addr) begin
+                $display("@%t | [JTAG] Writing to memory @%08x ", $time, word_addr);
+                jtag_dbg.write_dmi(dm::SBAddress0, word_addr);
             end
+            jtag_write(dm::SBData0, image[word_addr]);
+            next_addr = word_addr + 4;
         end
         jtag_dbg.write_dmi(dm::SBCS, JtagInitSbcs);
-        $fclose(file);
     endtask
 
     // Wait for termination signal and get return code
@@ -299,6 +304,131 @@ module tb_croc_soc #(
     endtask
 
 
+    ///////////////////////
+    //  SRAM Preloading  //
+    ///////////////////////
+    // Backdoor alternative to `jtag_load_hex`: the image is written straight into the memory
+    // arrays of the SRAM banks (`gen_sram_bank` in croc_domain) while the core is not fetching.
+`ifndef TARGET_NETLIST_YOSYS
+
+    localparam int unsigned SramNumWords = croc_pkg::NumSramBanks * croc_pkg::SramBankNumWords;
+
+    logic [31:0] preload_image [croc_pkg::NumSramBanks][croc_pkg::SramBankNumWords];
+    bit          preload_valid [croc_pkg::NumSramBanks][croc_pkg::SramBankNumWords];
+    event        preload_write;
+
+    // map an SRAM word index to its bank and the word index inside that bank
+    function automatic void sram_word_to_bank(
+        input  int unsigned word,
+        output int unsigned bank,
+        output int unsigned bank_word
+    );
+        if (croc_pkg::SramInterleave) begin
+            bank      = word % croc_pkg::NumSramBanks;
+            bank_word = word / croc_pkg::NumSramBanks;
+        end else begin
+            bank      = word / croc_pkg::SramBankNumWords;
+            bank_word = word % croc_pkg::SramBankNumWords;
+        end
+    endfunction
+
+    // Parse the binary formated as 32bit hex file and write it into the SRAM banks
+    task automatic preload_load_hex(input string filename, output bit [31:0] base_addr);
+        int file;
+        string token, addr_str;
+        bit [31:0] addr;
+        bit [ 7:0] byte_data;
+        bit        base_found;
+        int unsigned word, bank, bank_word, num_words;
+
+        file = $fopen(filename, "r");
+        if (file == 0) begin
+            $fatal(1, "Error: Failed to open file %s", filename);
+        end
+
+        $display("@%t | [PRELOAD] Loading binary from %s", $time, filename);
+        foreach (preload_valid[i,j]) preload_valid[i][j] = 1'b0;
+        base_found = 1'b0;
+        num_words  = 0;
+
+        // whitespace separated tokens: either '@<addr>' or one '<byte>'
+        while ($fscanf(file, "%s", token) == 1) begin
+            if (token[0] == "@") begin
+                addr_str = token.substr(1, token.len()-1);
+                addr     = addr_str.atohex();
+                if (!base_found) begin
+                    base_addr  = addr;
+                    base_found = 1'b1;
+                end
+                $display("@%t | [PRELOAD] Writing to memory @%08x ", $time, addr);
+                continue;
+            end
+
+            byte_data = token.atohex();
+            if (addr < croc_pkg::SramBaseAddr || addr >= croc_pkg::SramBaseAddr + SramNumWords*4)
+                $fatal(1, "@%t | [PRELOAD] Address 0x%h outside of SRAM!", $time, addr);
+
+            word = (addr - croc_pkg::SramBaseAddr) >> 2;
+            sram_word_to_bank(word, bank, bank_word);
+            if (!preload_valid[bank][bank_word]) begin
+                preload_image[bank][bank_word] = '0;
+                preload_valid[bank][bank_word] = 1'b1;
+                num_words++;
+            end
+            preload_image[bank][bank_word][8*addr[1:0] +: 8] = byte_data;
+            addr += 1;
+        end
+        $fclose(file);
+
+        // every bank copies its slice of the image into its memory array
+        ->preload_write;
+        @(posedge clk);
+        $display("@%t | [PRELOAD] Wrote %0d words", $time, num_words);
+    endtask
+
+    for (genvar b = 0; b < croc_pkg::NumSramBanks; b++) begin : gen_sram_preload
+        initial forever begin
+            @(preload_write);
+            for (int unsigned w = 0; w < croc_pkg::SramBankNumWords; w++) begin
+                if (preload_valid[b][w])
+                    i_croc_soc.i_croc.gen_sram_bank[b].i_sram.i_tc_sram.sram[w] = preload_image[b][w];
+            end
+        end
+    end
+
+    // Bank conflicts: cycles in which more than one manager requests the same SRAM bank
+    int unsigned sram_conflicts = 0;
+
+    always @(posedge clk) begin
+        int unsigned bank_reqs [croc_pkg::NumSramBanks];
+        bit [31:0] addr;
+        foreach (bank_reqs[b]) bank_reqs[b] = 0;
+        for (int m = 0; m < croc_pkg::NumXbarManagers; m++) begin
+            addr = i_croc_soc.i_croc.xbar_mgr_obi_req[m].a.addr; // already remapped
+            if (i_croc_soc.i_croc.xbar_mgr_obi_req[m].req && addr >= croc_pkg::SramBaseAddr &&
+                addr < croc_pkg::SramBaseAddr + SramNumWords*4)
+                bank_reqs[(addr - croc_pkg::SramBaseAddr) / (croc_pkg::SramBankNumWords*4)]++;
+        end
+        foreach (bank_reqs[b]) if (bank_reqs[b] > 1) begin
+            sram_conflicts++;
+            break;
+        end
+    end
+
+    final $display("@%t | [SRAM] %0d bank conflict cycles (interleave: %0d)", $time,
+                   sram_conflicts, croc_pkg::SramInterleave);
+
+    // Poll the core status register through the backdoor instead of the JTAG system bus
+    task automatic preload_wait_for_eoc(output bit [31:0] exit_code);
+        do begin
+            repeat(100) @(posedge clk);
+            exit_code = i_croc_soc.i_croc.soc_ctrl_reg2hw.corestatus.q;
+        end while (exit_code == 0);
+        $display("@%t | [CORE] Simulation finished: return code 0x%0h", $time, exit_code);
+    endtask
+`endif
+
+
     ////////////
     //  UART  //
     ////////////
@@ -362,6 +492,32 @@ module tb_croc_soc #(
         #UartBaudPeriod;
     endtask
 
+    // Decoder for the binary LOG() records (sw/lib/inc/log.h), called with the ELF of the binary
+    // (+log_elf=<path>, default: +binary with .elf instead of .hex) and the record as hex bytes
+    string log_decoder = "python3 ../sw/scripts/log_decode.py";
+    string log_elf;
+
+    initial begin
+        void'($value$plusargs("log_decoder=%s", log_decoder));
+        if (!$value$plusargs("log_elf=%s", log_elf)) begin
+            @(posedge fetch_en_i);
+            log_elf = {binary_path.substr(0, binary_path.len()-5), ".elf"};
+        end
+    end
+
+    task automatic uart_read_log_record(input byte_bt header);
+        automatic string record = $sformatf("%02x", header);
+        byte_bt bite;
+        // string id, then 4 bytes per argument
+        for (int i = 0; i < 2 + 4*header[6:0]; i++) begin
+            uart_read_byte(bite);
+            record = {record, $sformatf("%02x", bite)};
+        end
+        $write("@%t | [LOG] ", $time);
+        $fflush();
+        void'($system({log_decoder, " ", log_elf, " --record ", record}));
+    endtask
+
     // Continually read characters and print lines
     // TODO: we should be able to support CR properly, but buffers are hard to deal with...
     initial begin
@@ -373,7 +529,9 @@ module tb_croc_soc #(
         forever begin
             uart_read_byte(bite);
             
-            if (bite == "\n" || uart_read_buf.size() > 80) begin
+            if (bite[7]) begin
+                uart_read_log_record(bite);
+            end else if (bite == "\n" || uart_read_buf.size() > 80) begin
                  if (uart_read_buf.size() > 0) begin
                     automatic string uart_str = "";               
                     foreach (uart_read_buf[i]) begin
@@ -447,6 +605,7 @@ module tb_croc_soc #(
     /////////////////
 
     logic [31:0] tb_data;
+    bit   [31:0] boot_addr;
 
     initial begin
         $timeformat(-9, 0, "ns", 12); // 1: scale (ns=-9), 2: decimals, 3: suffix, 4: print-field width
@@ -461,6 +620,35 @@ module tb_croc_soc #(
         // wait for reset
         #ClkPeriod;
 
+        if (preload) begin
+            `ifdef TARGET_NETLIST_YOSYS
+            $fatal(1, "[PRELOAD] Not supported in netlist simulation, use the JTAG loader");
+            `else
+            // load binary to sram
+            wait (rst_n);
+            preload_load_hex(binary_path, boot_addr);
+
+            // the boot address register resets to the start of SRAM, only reprogram if needed
+            if (boot_addr != croc_pkg::SramBaseAddr) begin
+                jtag_init();
+                jtag_write_reg32(BootAddrAddr, boot_addr);
+            end
+
+            $display("@%t | [CORE] Start fetching instructions", $time);
+            fetch_en_i = 1'b1;
+
+            // wait for non-zero return value (written into core status register)
+            $display("@%t | [CORE] Wait for end of code...", $time);
+            preload_wait_for_eoc(tb_data);
+
+            repeat(50) @(posedge clk);
+            `ifdef TRACE_WAVE
+            $dumpflush;
+            `endif
+            $finish();
+            `endif
+        end
+
         // init jtag
         jtag_init();
 
@@ -0,0 +1,120 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+// Timing-free top for the C++ Verilator harness (verilator/sim_main.cpp).
+// There are no delays or event controls in here: clocks, reset, fetch enable and the UART
+// monitor are all driven from C++. The binary is parsed by the harness and preloaded into the
+// SRAM banks at time zero through the `sim_preload_word` DPI call.
+
+module tb_croc_soc_fast #(
+  parameter int unsigned GpioCount = 32
+) (
+  input  logic        clk_i,
+  input  logic        rst_ni,
+  input  logic        ref_clk_i,
+  input  logic        fetch_en_i,
+
+  input  logic        uart_rx_i,
+  output logic        uart_tx_o,
+
+  output logic [31:0] exit_code_o, // soc_ctrl core status, non-zero at end of code
+  output logic        status_o
+);
+
+  logic [GpioCount-1:0] gpio_i;
+  logic [GpioCount-1:0] gpio_o;
+  logic [GpioCount-1:0] gpio_out_en_o;
+
+  ////////////
+  //  DUT   //
+  ////////////
+
+  croc_soc #(
+    .GpioCount      ( GpioCount  ),
+    .N_PULSER_INST  ( 8          ),
+    .AdvTimer       ( 4          )
+  ) i_croc_soc (
+    .clk_i         ( clk_i      ),
+    .rst_ni        ( rst_ni     ),
+    .ref_clk_i     ( ref_clk_i  ),
+    .testmode_i    ( 1'b0       ),
+    .fetch_en_i    ( fetch_en_i ),
+    .status_o      ( status_o   ),
+
+    // JTAG is unused, keep the TAP in reset
+    .jtag_tck_i    ( 1'b0 ),
+    .jtag_tdi_i    ( 1'b0 ),
+    .jtag_tdo_o    (      ),
+    .jtag_tms_i    ( 1'b0 ),
+    .jtag_trst_ni  ( 1'b0 ),
+
+    .uart_rx_i     ( uart_rx_i ),
+    .uart_tx_o     ( uart_tx_o ),
+
+    .pulse_o       (               ),
+
+    .ch_0_o        (               ),
+    .ch_1_o        (               ),
+    .ch_2_o        (               ),
+    .ch_3_o        (               ),
+
+    .gpio_i        ( gpio_i        ),
+    .gpio_o        ( gpio_o        ),
+    .gpio_out_en_o ( gpio_out_en_o )
+  );
+
+  assign gpio_i[ 3:0]          = '0;
+  assign gpio_i[ 7:4]          = gpio_out_en_o[3:0] & gpio_o[3:0]; // loop back
+  assign gpio_i[GpioCount-1:8] = '0;
+
+  assign exit_code_o = i_croc_soc.i_croc.soc_ctrl_reg2hw.corestatus.q;
+
+
+  ///////////////////////
+  //  SRAM Preloading  //
+  ///////////////////////
+
+  // Returns 1 and the word at the (word aligned) byte address if the binary contains it
+  import "DPI-C" function bit sim_preload_word(input int addr, output int data);
+
+  for (genvar b = 0; b < croc_pkg::NumSramBanks; b++) begin : gen_sram_preload
+    initial begin
+      int data;
+      int unsigned word;
+      for (int unsigned w = 0; w < croc_pkg::SramBankNumWords; w++) begin
+        // SRAM word index of word w in bank b
+        word = croc_pkg::SramInterleave ? w*croc_pkg::NumSramBanks + b
+                                        : b*croc_pkg::SramBankNumWords + w;
+        if (sim_preload_word(croc_pkg::SramBaseAddr + word*4, data))
+          i_croc_soc.i_croc.gen_sram_bank[b].i_sram.i_tc_sram.sram[w] = data;
+      end
+    end
+  end
+
+
+  ///////////////////////////
+  //  SRAM Bank Conflicts  //
+  ///////////////////////////
+
+  // Cycles in which more than one manager requests the same SRAM bank, reported at exit
+  int unsigned sram_conflicts = 0;
+
+  always_ff @(posedge clk_i) begin
+    automatic int unsigned bank_reqs [croc_pkg::NumSramBanks] = '{default: 0};
+    automatic bit          conflict = 1'b0;
+    for (int m = 0; m < croc_pkg::NumXbarManagers; m++) begin
+      automatic logic [31:0] addr = i_croc_soc.i_croc.xbar_mgr_obi_req[m].a.addr; // remapped
+      if (i_croc_soc.i_croc.xbar_mgr_obi_req[m].req && addr >= croc_pkg::SramBaseAddr &&
+          addr < croc_pkg::SramBaseAddr + croc_pkg::SramAddrRange)
+        bank_reqs[(addr - croc_pkg::SramBaseAddr) / (croc_pkg::SramBankNumWords*4)]++;
+    end
+    for (int b = 0; b < croc_pkg::NumSramBanks; b++)
+      conflict |= bank_reqs[b] > 1;
+    if (conflict) sram_conflicts <= sram_conflicts + 1;
+  end
+
+  final $display("[SRAM] %0d bank conflict cycles (interleave: %0d)", sram_conflicts,
+                 croc_pkg::SramInterleave);
+
+endmodule
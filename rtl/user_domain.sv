@@ -24,15 +24,19 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   output logic [NumExternalIrqs-1:0] interrupts_o // interrupts to core
 );
 
-  assign interrupts_o = '0;  
+  logic dma_irq;
+
+  always_comb begin
+    interrupts_o             = '0;
+    interrupts_o[UserDmaIrq] = dma_irq;
+  end
 
 
   //////////////////////
   // User Manager MUX //
   /////////////////////
 
-  // No manager so we don't need a obi_mux module and just terminate the request properly
-  assign user_mgr_obi_req_o = '0;
+  // Only one manager (the DMA) so we don't need a obi_mux module, it drives the port directly
 
 
   ////////////////////////////
@@ -55,6 +59,10 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   sbr_obi_req_t user_rom_obi_req;
   sbr_obi_rsp_t user_rom_obi_rsp;
 
+  // DMA Subordinate Bus
+  sbr_obi_req_t user_dma_obi_req;
+  sbr_obi_rsp_t user_dma_obi_rsp;
+
   // Fanout into more readable signals
   assign user_error_obi_req              = all_user_sbr_obi_req[UserError];
   assign all_user_sbr_obi_rsp[UserError] = user_error_obi_rsp;
@@ -62,6 +70,9 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   assign user_rom_obi_req                = all_user_sbr_obi_req[UserRom];
   assign all_user_sbr_obi_rsp[UserRom]   = user_rom_obi_rsp;
 
+  assign user_dma_obi_req                = all_user_sbr_obi_req[UserDma];
+  assign all_user_sbr_obi_rsp[UserDma]   = user_dma_obi_rsp;
+
 
   //-----------------------------------------------------------------------------------------------
   // Demultiplex to User Subordinates according to address map
@@ -135,4 +146,22 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
     .obi_rsp_o  ( user_rom_obi_rsp )
   );
 
+  // DMA engine, registers on the subordinate bus, transfers on the user manager port
+  user_dma #(
+    .SbrObiCfg   ( SbrObiCfg     ),
+    .sbr_req_t   ( sbr_obi_req_t ),
+    .sbr_rsp_t   ( sbr_obi_rsp_t ),
+    .MgrObiCfg   ( MgrObiCfg     ),
+    .mgr_req_t   ( mgr_obi_req_t ),
+    .mgr_rsp_t   ( mgr_obi_rsp_t )
+  ) i_user_dma (
+    .clk_i,
+    .rst_ni,
+    .sbr_obi_req_i ( user_dma_obi_req   ),
+    .sbr_obi_rsp_o ( user_dma_obi_rsp   ),
+    .mgr_obi_req_o ( user_mgr_obi_req_o ),
+    .mgr_obi_rsp_i ( user_mgr_obi_rsp_i ),
+    .irq_o         ( dma_irq            )
+  );
+
 endmodule
@@ -0,0 +1,278 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Authors:
+// - Nico Canzani <ncanzani@student.ethz.ch>
+
+// gives us the `FF(...) macro making it easy to have properly defined flip-flops
+`include "common_cells/registers.svh"
+
+// Single channel DMA engine
+// Copies LEN bytes from SRC to DST in elements of 1, 2 or 4 bytes over its OBI manager port.
+// Source and destination either increment (memory) or stay fixed (peripheral register), which
+// gives mem-to-mem, mem-to-peripheral and peripheral-to-mem transfers. There is no handshake
+// with the peripherals, a transfer to or from a FIFO must not exceed its free space/fill level.
+//
+// Registers (word offsets from the subordinate base address):
+// 0x00 SRC    source address
+// 0x04 DST    destination address
+// 0x08 LEN    transfer length in bytes, a multiple of the element size
+// 0x0C CTRL   [0] START (write 1, ignored while busy), [1] SRC_FIXED, [2] DST_FIXED,
+//             [4:3] SIZE (0: byte, 1: half-word, 2: word), [5] IRQ_EN
+// 0x10 STATUS [0] BUSY, [1] DONE, [2] ERROR (a bus error aborted the transfer)
+//             DONE and ERROR are cleared by writing 1 or by the next START
+// SRC, DST, LEN, SIZE and the FIXED bits are copied when a transfer starts, so the next one can
+// be set up while busy. IRQ_EN takes effect immediately.
+module user_dma #(
+  /// The OBI configuration of the subordinate (register) port.
+  parameter obi_pkg::obi_cfg_t           SbrObiCfg   = obi_pkg::ObiDefaultConfig,
+  /// The subordinate request struct.
+  parameter type                         sbr_req_t   = logic,
+  /// The subordinate response struct.
+  parameter type                         sbr_rsp_t   = logic,
+  /// The OBI configuration of the manager (transfer) port.
+  parameter obi_pkg::obi_cfg_t           MgrObiCfg   = obi_pkg::ObiDefaultConfig,
+  /// The manager request struct.
+  parameter type                         mgr_req_t   = logic,
+  /// The manager response struct.
+  parameter type                         mgr_rsp_t   = logic
+) (
+  /// Clock
+  input  logic clk_i,
+  /// Active-low reset
+  input  logic rst_ni,
+
+  /// OBI subordinate interface (registers)
+  input  sbr_req_t sbr_obi_req_i,
+  output sbr_rsp_t sbr_obi_rsp_o,
+
+  /// OBI manager interface (transfers)
+  output mgr_req_t mgr_obi_req_o,
+  input  mgr_rsp_t mgr_obi_rsp_i,
+
+  /// Transfer finished (DONE or ERROR) while IRQ_EN is set
+  output logic irq_o
+);
+
+  localparam int unsigned RegSrc    = 0;
+  localparam int unsigned RegDst    = 1;
+  localparam int unsigned RegLen    = 2;
+  localparam int unsigned RegCtrl   = 3;
+  localparam int unsigned RegStatus = 4;
+
+  typedef enum logic [1:0] {
+    Idle,
+    ReadReq,
+    WriteReq,
+    WaitRsp
+  } dma_state_e;
+
+  // ---------
+  // Registers
+  // ---------
+  logic [31:0] src_d, src_q, dst_d, dst_q, len_d, len_q;
+  logic        src_fixed_d, src_fixed_q, dst_fixed_d, dst_fixed_q, irq_en_d, irq_en_q;
+  logic [ 1:0] size_d, size_q;
+  logic        done_d, done_q, error_d, error_q;
+  logic        start;
+
+  // subordinate response, one cycle after the request
+  logic                          rsp_valid_d, rsp_valid_q;
+  logic [SbrObiCfg.IdWidth-1:0]  rsp_id_d, rsp_id_q;
+  logic [SbrObiCfg.DataWidth-1:0] rsp_data_d, rsp_data_q;
+
+  // transfer state
+  dma_state_e  state_d, state_q;
+  logic        write_phase_d, write_phase_q; // WaitRsp: waiting for the write (1) or read (0)
+  logic [31:0] cur_src_d, cur_src_q, cur_dst_d, cur_dst_q, remaining_d, remaining_q;
+  logic        cur_src_fixed_d, cur_src_fixed_q, cur_dst_fixed_d, cur_dst_fixed_q;
+  logic [ 1:0] cur_size_d, cur_size_q;
+  logic [31:0] data_d, data_q;
+  logic [ 2:0] elem_bytes;
+  logic [31:0] rdata_shifted;
+
+  logic busy;
+  assign busy = (state_q != Idle);
+
+  logic [2:0] reg_idx;
+  assign reg_idx = sbr_obi_req_i.a.addr[4:2];
+
+  always_comb begin
+    src_d       = src_q;
+    dst_d       = dst_q;
+    len_d       = len_q;
+    src_fixed_d = src_fixed_q;
+    dst_fixed_d = dst_fixed_q;
+    size_d      = size_q;
+    irq_en_d    = irq_en_q;
+    start       = 1'b0;
+    rsp_data_d  = '0;
+
+    if (sbr_obi_req_i.req && sbr_obi_req_i.a.we) begin
+      case (reg_idx)
+        RegSrc: src_d = sbr_obi_req_i.a.wdata;
+        RegDst: dst_d = sbr_obi_req_i.a.wdata;
+        RegLen: len_d = sbr_obi_req_i.a.wdata;
+        RegCtrl: begin
+          start       = sbr_obi_req_i.a.wdata[0] & ~busy;
+          src_fixed_d = sbr_obi_req_i.a.wdata[1];
+          dst_fixed_d = sbr_obi_req_i.a.wdata[2];
+          size_d      = sbr_obi_req_i.a.wdata[4:3];
+          irq_en_d    = sbr_obi_req_i.a.wdata[5];
+        end
+        default: ;
+      endcase
+    end else if (sbr_obi_req_i.req) begin
+      case (reg_idx)
+        RegSrc:    rsp_data_d = src_q;
+        RegDst:    rsp_data_d = dst_q;
+        RegLen:    rsp_data_d = len_q;
+        RegCtrl:   rsp_data_d = {26'b0, irq_en_q, size_q, dst_fixed_q, src_fixed_q, 1'b0};
+        RegStatus: rsp_data_d = {29'b0, error_q, done_q, busy};
+        default: ;
+      endcase
+    end
+  end
+
+  assign rsp_valid_d = sbr_obi_req_i.req;
+  assign rsp_id_d    = sbr_obi_req_i.a.aid;
+
+  `FF(src_q,       src_d,       '0)
+  `FF(dst_q,       dst_d,       '0)
+  `FF(len_q,       len_d,       '0)
+  `FF(src_fixed_q, src_fixed_d, '0)
+  `FF(dst_fixed_q, dst_fixed_d, '0)
+  `FF(size_q,      size_d,      2'd2)
+  `FF(irq_en_q,    irq_en_d,    '0)
+  `FF(rsp_valid_q, rsp_valid_d, '0)
+  `FF(rsp_id_q,    rsp_id_d,    '0)
+  `FF(rsp_data_q,  rsp_data_d,  '0)
+
+  assign sbr_obi_rsp_o.gnt          = sbr_obi_req_i.req;
+  assign sbr_obi_rsp_o.rvalid       = rsp_valid_q;
+  assign sbr_obi_rsp_o.r.rdata      = rsp_data_q;
+  assign sbr_obi_rsp_o.r.rid        = rsp_id_q;
+  assign sbr_obi_rsp_o.r.err        = 1'b0;
+  assign sbr_obi_rsp_o.r.r_optional = '0;
+
+  // ---------------
+  // Transfer engine
+  // ---------------
+  // One outstanding transaction: read an element, write it, advance the addresses
+  assign elem_bytes    = 3'd1 << cur_size_q;
+  assign rdata_shifted = mgr_obi_rsp_i.r.rdata >> {cur_src_q[1:0], 3'b000};
+
+  always_comb begin
+    state_d         = state_q;
+    write_phase_d   = write_phase_q;
+    cur_src_d       = cur_src_q;
+    cur_dst_d       = cur_dst_q;
+    remaining_d     = remaining_q;
+    cur_src_fixed_d = cur_src_fixed_q;
+    cur_dst_fixed_d = cur_dst_fixed_q;
+    cur_size_d      = cur_size_q;
+    data_d          = data_q;
+    done_d          = done_q;
+    error_d         = error_q;
+
+    mgr_obi_req_o              = '0;
+    mgr_obi_req_o.a.addr       = cur_src_q;
+    mgr_obi_req_o.a.be         = '1;
+
+    // clear on write 1
+    if (sbr_obi_req_i.req && sbr_obi_req_i.a.we && reg_idx == RegStatus) begin
+      done_d  = done_q  & ~sbr_obi_req_i.a.wdata[1];
+      error_d = error_q & ~sbr_obi_req_i.a.wdata[2];
+    end
+
+    unique case (state_q)
+      Idle: begin
+        if (start) begin
+          done_d          = 1'b0;
+          error_d         = 1'b0;
+          cur_src_d       = src_q;
+          cur_dst_d       = dst_q;
+          remaining_d     = len_q;
+          // the mode bits come with the START write, take them from that write
+          cur_src_fixed_d = src_fixed_d;
+          cur_dst_fixed_d = dst_fixed_d;
+          cur_size_d      = size_d;
+          if (len_q == '0) done_d  = 1'b1;
+          else             state_d = ReadReq;
+        end
+      end
+
+      ReadReq: begin
+        mgr_obi_req_o.req    = 1'b1;
+        mgr_obi_req_o.a.addr = cur_src_q;
+        if (mgr_obi_rsp_i.gnt) begin
+          write_phase_d = 1'b0;
+          state_d       = WaitRsp;
+        end
+      end
+
+      WriteReq: begin
+        mgr_obi_req_o.req     = 1'b1;
+        mgr_obi_req_o.a.we    = 1'b1;
+        mgr_obi_req_o.a.addr  = cur_dst_q;
+        mgr_obi_req_o.a.wdata = data_q;
+        unique case (cur_size_q)
+          2'd0:    mgr_obi_req_o.a.be = 4'b0001 << cur_dst_q[1:0];
+          2'd1:    mgr_obi_req_o.a.be = 4'b0011 << cur_dst_q[1:0];
+          default: mgr_obi_req_o.a.be = 4'b1111;
+        endcase
+        if (mgr_obi_rsp_i.gnt) begin
+          write_phase_d = 1'b1;
+          state_d       = WaitRsp;
+        end
+      end
+
+      WaitRsp: begin
+        if (mgr_obi_rsp_i.rvalid) begin
+          if (mgr_obi_rsp_i.r.err) begin
+            error_d = 1'b1;
+            done_d  = 1'b1;
+            state_d = Idle;
+          end else if (!write_phase_q) begin
+            // move the element to the byte lanes of every possible destination offset
+            unique case (cur_size_q)
+              2'd0:    data_d = {4{rdata_shifted[ 7:0]}};
+              2'd1:    data_d = {2{rdata_shifted[15:0]}};
+              default: data_d = mgr_obi_rsp_i.r.rdata;
+            endcase
+            state_d = WriteReq;
+          end else begin
+            if (!cur_src_fixed_q) cur_src_d = cur_src_q + elem_bytes;
+            if (!cur_dst_fixed_q) cur_dst_d = cur_dst_q + elem_bytes;
+            remaining_d = remaining_q - elem_bytes;
+            if (remaining_q <= elem_bytes) begin
+              remaining_d = '0;
+              done_d      = 1'b1;
+              state_d     = Idle;
+            end else begin
+              state_d     = ReadReq;
+            end
+          end
+        end
+      end
+
+      default: state_d = Idle;
+    endcase
+  end
+
+  `FF(state_q,         state_d,         Idle)
+  `FF(write_phase_q,   write_phase_d,   '0)
+  `FF(cur_src_q,       cur_src_d,       '0)
+  `FF(cur_dst_q,       cur_dst_d,       '0)
+  `FF(remaining_q,     remaining_d,     '0)
+  `FF(cur_src_fixed_q, cur_src_fixed_d, '0)
+  `FF(cur_dst_fixed_q, cur_dst_fixed_d, '0)
+  `FF(cur_size_q,      cur_size_d,      2'd2)
+  `FF(data_q,          data_d,          '0)
+  `FF(done_q,          done_d,          '0)
+  `FF(error_q,         error_d,         '0)
+
+  assign irq_o = done_q & irq_en_q;
+
+endmodule
@@ -15,31 +15,39 @@ package user_pkg;
   // User Manager Address maps //
   ///////////////////////////////
   
-  // None
+  // The DMA engine is the only manager, it is directly connected to the user manager port
 
 
   /////////////////////////////////////
   // User Subordinate Address maps ////
   /////////////////////////////////////
 
-  localparam int unsigned NumUserDomainSubordinates = 1;
+  localparam int unsigned NumUserDomainSubordinates = 2;
 
   localparam bit [31:0] UserRomAddrOffset   = croc_pkg::UserBaseAddr;    // 32'h2000_0000;
   localparam bit [31:0] UserRomAddrRange    = 32'h0000_1000;             // every subordinate has at least 4KB
 
+  localparam bit [31:0] UserDmaAddrOffset   = UserRomAddrOffset + UserRomAddrRange; // 32'h2000_1000;
+  localparam bit [31:0] UserDmaAddrRange    = 32'h0000_1000;
+
   localparam int unsigned NumDemuxSbrRules  = NumUserDomainSubordinates; // number of address rules in the decoder
   localparam int unsigned NumDemuxSbr       = NumDemuxSbrRules + 1;      // additional OBI error, used for signal arrays
 
   // Enum for bus indices
   typedef enum int {
     UserError = 0,
-    UserRom = 1
+    UserRom = 1,
+    UserDma = 2
   } user_demux_outputs_e;
 
   // Address rules given to address decoder
   localparam croc_pkg::addr_map_rule_t [NumDemuxSbrRules-1:0] user_addr_map = '{
+    '{ idx:UserDma, start_addr: UserDmaAddrOffset, end_addr: UserDmaAddrOffset + UserDmaAddrRange},
     '{ idx:UserRom, start_addr: UserRomAddrOffset, end_addr: UserRomAddrOffset + UserRomAddrRange}
   };
 
+  // Interrupt lines (interrupts_o), core fast interrupt 3 + index
+  localparam int unsigned UserDmaIrq = 0;
+
 
 endpackage
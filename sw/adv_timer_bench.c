@@ -0,0 +1,63 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Advanced timer update benchmark: runs 16 PWM outputs (4 timers x 4 channels) and changes all
+// duty cycles, once with read-modify-write accesses per channel and once through the register
+// copy of the driver (adv_timer.h) with a single TIM_CMD_UPDATE per timer.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "adv_timer.h"
+#include "util.h"
+#include "config.h"
+
+#define BENCH_PERIOD 100
+
+// the way the timer0_* functions used to do it
+static void update_rmw(int threshold) {
+    for (int t = 0; t < ADV_TIMER_N_TIMERS; t++) {
+        for (int ch = 0; ch < ADV_TIMER_N_CHANNELS; ch++) {
+            uint32_t th = *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CH_TH(t, ch)) & ~0xFFFFu;
+            *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CH_TH(t, ch)) = th | (threshold + ch);
+        }
+        *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CMD(t)) |= TIM_CMD_UPDATE;
+    }
+}
+
+static void update_shadow(int threshold) {
+    for (int t = 0; t < ADV_TIMER_N_TIMERS; t++) {
+        for (int ch = 0; ch < ADV_TIMER_N_CHANNELS; ch++)
+            adv_timer_set_threshold(t, ch, threshold + ch);
+    }
+    adv_timer_commit(0xF);
+}
+
+int main() {
+    uart_init();
+
+    for (int t = 0; t < ADV_TIMER_N_TIMERS; t++) {
+        adv_timer_pwm_init(t, 0, BENCH_PERIOD, 50);
+        for (int ch = 1; ch < ADV_TIMER_N_CHANNELS; ch++)
+            adv_timer_set_channel(t, ch, TIM_CH_MODE_SETRST, BENCH_PERIOD / 2);
+    }
+    adv_timer_commit(0xF);
+
+    uint32_t start, cycles_rmw, cycles_shadow;
+
+    start      = (uint32_t)get_mcycle();
+    update_rmw(20);
+    cycles_rmw = (uint32_t)get_mcycle() - start;
+
+    start         = (uint32_t)get_mcycle();
+    update_shadow(30);
+    cycles_shadow = (uint32_t)get_mcycle() - start;
+
+    printf("16 channel update, rmw: 0x%x cycles, shadow: 0x%x cycles\n", cycles_rmw, cycles_shadow);
+    printf("timer 3 channel 3 threshold: 0x%x\n", adv_timer_get_threshold(3, 3));
+
+    uart_write_flush();
+    return 1;
+}
@@ -0,0 +1,92 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Bit manipulation benchmark of the driver hot paths: pulser register field packing,
+// single-bit GPIO updates and hex formatting. Run it on a core with RV32B != 0 and compare
+// the firmware built with and without Zba/Zbb/Zbs (`make sw-rv32b-report RV32B=1`).
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "pulser.h"
+#include "util.h"
+#include "config.h"
+
+#define BENCH_N 32
+
+// registers are emulated in SRAM so only the core is measured, not the peripheral bus
+static volatile uint32_t bench_reg;
+static volatile uint32_t bench_in[BENCH_N];
+
+// field packing as in pulser_set_f1_end_switch/pulser_set_f1_f2_stop_count and read back
+static uint32_t kernel_fields() {
+    uint32_t acc = 0;
+    for (int i = 0; i < BENCH_N; i++) {
+        uint32_t reg = 0;
+        reg = bitfield_set_field32(PULSER_CORE_CFG_CNT_F1_FIELD, reg, bench_in[i]);
+        reg = bitfield_set_field32(PULSER_CORE_CFG_CNT_F2_FIELD, reg, bench_in[i] >> 3);
+        reg = bitfield_set_field32(PULSER_CORE_CFG_CNT_CNT_STOP_FIELD, reg, bench_in[i] >> 5);
+        bench_reg = reg;
+        acc += bitfield_get_field32(PULSER_CORE_CFG_CNT_F2_FIELD, bench_reg);
+    }
+    return acc;
+}
+
+// single-bit set/clear/test with variable pin numbers as in gpio_pin_*
+static uint32_t kernel_bits() {
+    uint32_t acc = 0;
+    for (int i = 0; i < BENCH_N; i++) {
+        int pin = bench_in[i] & 31;
+        bench_reg = bit_set(bench_reg, pin);
+        bench_reg = bit_clear(bench_reg, (pin + 7) & 31);
+        acc += bit_get(bench_reg, (pin + 3) & 31);
+    }
+    return acc;
+}
+
+// printf %x conversion
+static uint32_t kernel_hex() {
+    char buf[8];
+    uint32_t acc = 0;
+    for (int i = 0; i < BENCH_N; i++)
+        acc += format_hex32(buf, bench_in[i] << (i & 31));
+    return acc;
+}
+
+static void bench_report(const char *name, uint32_t cycles, uint32_t result) {
+    while (*name)
+        putchar(*name++);
+    printf(": 0x%x cycles (result 0x%x)\n", cycles, result);
+}
+
+int main() {
+    uart_init();
+
+    for (int i = 0; i < BENCH_N; i++)
+        bench_in[i] = 0x9E3779B9u * (i + 1);
+
+#ifdef __riscv_zbs
+    printf("Zba/Zbb/Zbs, %x iterations\n", BENCH_N);
+#else
+    printf("RV32I, %x iterations\n", BENCH_N);
+#endif
+
+    uint32_t start, result;
+
+    start  = (uint32_t)get_mcycle();
+    result = kernel_fields();
+    bench_report("fields", (uint32_t)get_mcycle() - start, result);
+
+    start  = (uint32_t)get_mcycle();
+    result = kernel_bits();
+    bench_report("bits", (uint32_t)get_mcycle() - start, result);
+
+    start  = (uint32_t)get_mcycle();
+    result = kernel_hex();
+    bench_report("hex", (uint32_t)get_mcycle() - start, result);
+
+    uart_write_flush();
+    return 1;
+}
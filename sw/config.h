@@ -14,6 +14,7 @@
 #define GPIO_BASE_ADDR 0x03005000
 #define TIMER_BASE_ADDR 0x0300A000
 #define USER_ROM_BASE_ADDR 0x20000000
+#define DMA_BASE_ADDR 0x20001000
 #define ADV_TIMER_BASE_ADDR 0x0300E000
 #define PULSER_BASE_ADDR 0x0300C000
 
@@ -26,9 +27,22 @@
 #define UART_BYTE_ALIGN 4
 #define UART_FREQ TB_FREQUENCY
 #define UART_BAUD TB_BAUDRATE
+// Ring buffer sizes of the interrupt-driven driver, must be powers of two (max 128)
+#define UART_TX_BUF_SIZE 64
+#define UART_RX_BUF_SIZE 16
+
+// printf line buffer (on the stack), written out with one uart_write_str() call
+#define PRINT_BUF_SIZE 64
+
+// Deferred logging (log.h): 0 sends LOG() records straight to the UART, otherwise they are
+// buffered in an SRAM ring of this many bytes (power of two) until log_flush()
+#define LOG_RING_SIZE 0
+
+// Cooperative tasks (task.h)
+#define TASK_MAX 4
 
 // Since SRAM is very limmited, select which part to compile and test.
-// Difficult to impossible to activate more than one test
+// Difficult to impossible to activate more than one test (RVC=1 builds leave more room)
 #define TEST_NOP                        1
 #define TEST_READ_ROM                   0
 #define TEST_REG_PART_F1                0
@@ -36,5 +50,10 @@
 #define TEST_REG_PART_CNT               0
 #define TEST_RUN_ALL_PULSERS            0
 #define TEST_RUN_PULSER_ONE_BY_ONE      0
+#define TEST_RUN_PULSER_QUEUE           0
+#define TEST_RUN_PULSER_IRQ             0
+#define TEST_RUN_PULSER_TRIGGER         0
 #define TEST_RUN_ADV_TIMER              0
 #define TEST_RUN_ADV_TIMER_INTERRUPT    0
+#define TEST_RUN_ADV_TIMER_CAPTURE      0
+#define TEST_RUN_DMA_MODES              0
@@ -0,0 +1,101 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// DMA benchmark: copies a buffer with the CPU and with the user domain DMA (dma.h) and
+// prints the cycles of both, then shows the peripheral modes by sending a string to the UART
+// and sampling the GPIO inputs into memory.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "dma.h"
+#include "gpio.h"
+#include "irq.h"
+#include "util.h"
+#include "config.h"
+
+#define DMA_BENCH_WORDS 128
+
+static uint32_t bench_src[DMA_BENCH_WORDS];
+static uint32_t bench_dst[DMA_BENCH_WORDS];
+static uint32_t gpio_samples[8];
+
+static volatile uint32_t dma_irq_status;
+
+static inline __attribute__((always_inline)) uint32_t mcycle32() {
+    uint32_t mcycle;
+    asm volatile("csrr %0, mcycle" : "=r"(mcycle)::"memory");
+    return mcycle;
+}
+
+static void dma_done(uint32_t status) {
+    dma_irq_status = status;
+}
+
+static void cpu_copy(volatile uint32_t *dst, const volatile uint32_t *src, uint32_t words) {
+    for (uint32_t i = 0; i < words; i++)
+        dst[i] = src[i];
+}
+
+// returns the number of differing words and clears the destination
+static uint32_t bench_check() {
+    uint32_t errors = 0;
+    for (int i = 0; i < DMA_BENCH_WORDS; i++) {
+        errors += bench_dst[i] != bench_src[i];
+        bench_dst[i] = 0;
+    }
+    return errors;
+}
+
+int main() {
+    uart_init();
+    uint32_t start, cycles;
+
+    for (int i = 0; i < DMA_BENCH_WORDS; i++)
+        bench_src[i] = 0xC0C50000 + i;
+
+    printf("Copy of 0x%x words [cycles]:\n", DMA_BENCH_WORDS);
+
+    start  = mcycle32();
+    cpu_copy(bench_dst, bench_src, DMA_BENCH_WORDS);
+    cycles = mcycle32() - start;
+    printf("cpu:        0x%x (errors 0x%x)\n", cycles, bench_check());
+
+    start  = mcycle32();
+    dma_memcpy(bench_dst, bench_src, sizeof(bench_src));
+    cycles = mcycle32() - start;
+    printf("dma:        0x%x (errors 0x%x)\n", cycles, bench_check());
+
+    // the CPU only pays for the setup, the rest of the time it is free (here: sleeps in wfi)
+    dma_set_callback(dma_done);
+    set_mie(1);
+    dma_irq_status = 0;
+    start  = mcycle32();
+    dma_start(bench_dst, bench_src, sizeof(bench_src), DMA_MEM_TO_MEM, DMA_SIZE_WORD);
+    cycles = mcycle32() - start;
+    while (!dma_irq_status)
+        wfi();
+    uint32_t total = mcycle32() - start;
+    printf("dma setup:  0x%x, done irq after 0x%x (errors 0x%x)\n", cycles, total, bench_check());
+    set_mie(0);
+    dma_set_callback(0);
+
+    // mem-to-peripheral: bytes into the UART transmit FIFO, at most UART_FIFO_DEPTH at once
+    static const char msg[] = "DMA to UART!\n";
+    uart_write_flush();
+    dma_start(reg8(UART_BASE_ADDR, UART_THR_REG_OFFSET), msg, sizeof(msg) - 1, DMA_MEM_TO_PERIPH,
+              DMA_SIZE_BYTE);
+    dma_wait();
+    uart_write_flush();
+
+    // peripheral-to-mem: sample the GPIO inputs as fast as the bus allows
+    dma_start(gpio_samples, reg32(GPIO_BASE_ADDR, GPIO_IN_REG_OFFSET), sizeof(gpio_samples),
+              DMA_PERIPH_TO_MEM, DMA_SIZE_WORD);
+    int status = dma_wait();
+    printf("gpio in: 0x%x (status 0x%x)\n", gpio_samples[0], status);
+
+    uart_write_flush();
+    return 1;
+}
@@ -0,0 +1,66 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// GPIO pattern stream benchmark: toggles GPIO 0 as fast as possible, once from a CPU loop and
+// once from a table played by the pattern stream (gpio.h), and measures the edge spacing with
+// the adv timer input capture on the testbench loopback GPIO 0 -> GPIO 4.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "gpio.h"
+#include "adv_timer.h"
+#include "util.h"
+#include "config.h"
+
+#define BENCH_EDGES  ADV_TIMER_CAP_DEPTH
+#define BENCH_PERIOD 2 // stream output period in clock cycles
+
+static uint32_t pattern[BENCH_EDGES];
+
+static void report(const char *name) {
+    uint32_t ts[BENCH_EDGES];
+    int n = adv_timer_capture_read(ts, BENCH_EDGES);
+    uint32_t min = ~0u, max = 0;
+    for (int i = 1; i < n; i++) {
+        uint32_t d = CAP_DELTA(ts[i], ts[i - 1]);
+        if (d < min) min = d;
+        if (d > max) max = d;
+    }
+    while (*name)
+        putchar(*name++);
+    printf(": 0x%x edges, spacing min 0x%x max 0x%x cycles\n", n, min, max);
+}
+
+int main() {
+    uart_init();
+
+    gpio_set_direction(1 << 0, 1 << 0);
+    gpio_enable(1 << 0);
+    gpio_write(0);
+
+    // CPU: one register write per edge, plus the loop
+    adv_timer_capture_init(4, 1, 1, 0, 0);
+    for (int i = 0; i < BENCH_EDGES; i++)
+        gpio_toggle(1 << 0);
+    for (volatile int d = 0; d < 8; d++)
+        ;
+    report("cpu");
+
+    // stream: a fixed period from the FIFO, GPIO 0 is low after an even number of toggles
+    for (int i = 0; i < BENCH_EDGES; i++)
+        pattern[i] = ~i & 1;
+    adv_timer_capture_init(4, 1, 1, 0, 0);
+    gpio_stream_init(1 << 0, BENCH_PERIOD);
+    gpio_stream_write(pattern, BENCH_EDGES); // fits into the FIFO
+    gpio_stream_start();
+    for (volatile int d = 0; d < 8; d++)
+        ;
+    report("stream");
+    gpio_stream_stop();
+
+    uart_write_flush();
+    return 1;
+}
@@ -46,6 +46,18 @@ int main()
     test_pulser_run_all();
 #endif
 
+#if TEST_RUN_PULSER_QUEUE
+    test_pulser_queue();
+#endif
+
+#if TEST_RUN_PULSER_IRQ
+    test_pulser_irq();
+#endif
+
+#if TEST_RUN_PULSER_TRIGGER
+    test_pulser_trigger();
+#endif
+
 
 #if TEST_RUN_ADV_TIMER
     test_adv_timer();
@@ -55,5 +67,13 @@ int main()
     test_adv_timer_interrupt();
 #endif
 
+#if TEST_RUN_ADV_TIMER_CAPTURE
+    test_adv_timer_capture();
+#endif
+
+#if TEST_RUN_DMA_MODES
+    test_dma_modes();
+#endif
+
     return 1;
 }
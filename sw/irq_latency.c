@@ -0,0 +1,154 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Interrupt-entry latency benchmark.
+// For each source the interrupt is triggered by a single store and the handler samples mcycle
+// as its first action. The printed numbers are the cycles from the triggering store to that
+// sample (minus the cost of the mcycle read itself), for the C dispatcher (irq_register) and
+// the fast path (irq_set_vector), as min/max over IRQ_BENCH_RUNS runs.
+// The GPIO source needs the testbench loopback of GPIO 0 to GPIO 4.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "timer.h"
+#include "gpio.h"
+#include "irq.h"
+#include "util.h"
+#include "config.h"
+
+#define IRQ_BENCH_RUNS      8
+#define IRQ_BENCH_TIMER_CMP 8 // timer target in system clock cycles, subtracted from the result
+
+static volatile uint32_t irq_start; // mcycle just before the triggering store
+static volatile uint32_t irq_cycle; // mcycle at handler entry
+static volatile uint32_t irq_done;
+
+static inline __attribute__((always_inline)) uint32_t mcycle32() {
+    uint32_t mcycle;
+    asm volatile("csrr %0, mcycle" : "=r"(mcycle)::"memory");
+    return mcycle;
+}
+
+// Handler bodies, shared by the dispatcher and the fast-path variant
+static inline __attribute__((always_inline)) void timer_ack() {
+    irq_cycle = mcycle32();
+    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = 0;
+    irq_done = 1;
+}
+
+static inline __attribute__((always_inline)) void uart_ack() {
+    irq_cycle = mcycle32();
+    *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET) = 0;
+    irq_done = 1;
+}
+
+static inline __attribute__((always_inline)) void gpio_ack() {
+    irq_cycle = mcycle32();
+    (void)*reg32(GPIO_BASE_ADDR, GPIO_INTRPT_STATUS_REG_OFFSET); // read clears
+    irq_done = 1;
+}
+
+static void timer_handler(void) { timer_ack(); }
+static void uart_handler(void)  { uart_ack(); }
+static void gpio_handler(void)  { gpio_ack(); }
+
+IRQ_FAST_HANDLER static void timer_isr(void) { timer_ack(); }
+IRQ_FAST_HANDLER static void uart_isr(void)  { uart_ack(); }
+IRQ_FAST_HANDLER static void gpio_isr(void)  { gpio_ack(); }
+
+// Triggers: prepare the source, then raise the interrupt with one store
+static void timer_trigger() {
+    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = 0;
+    *reg32(TIMER_BASE_ADDR, TIMER_VALUE_LOW_REG_OFFSET) = 0;
+    *reg32(TIMER_BASE_ADDR, TIMER_CMP_LOW_REG_OFFSET) = IRQ_BENCH_TIMER_CMP;
+    uint32_t config = (1 << CFG_LOW_REG_ONE_SHOT_BIT) |  // stop at target, keeps the irq high
+                      (1 << CFG_LOW_REG_IRQ_ENABLE_BIT) |
+                      (1 << CFG_LOW_REG_ENABLE_BIT);
+    irq_start = mcycle32();
+    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = config;
+}
+
+static void uart_trigger() {
+    uart_write_flush(); // THR must be empty
+    irq_start = mcycle32();
+    *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET) = (1 << UART_INTR_ENABLE_THR_EMPTY_BIT);
+}
+
+static void gpio_trigger() {
+    gpio_pin_clear(0);
+    irq_start = mcycle32();
+    *reg32(GPIO_BASE_ADDR, GPIO_TOGGLE_REG_OFFSET) = (1 << 0);
+}
+
+typedef struct {
+    const char *name;
+    int irq;
+    irq_handler_t handler;
+    void (*isr)(void);
+    void (*trigger)(void);
+    uint32_t offset; // known delay of the source itself
+} irq_bench_t;
+
+static const irq_bench_t irq_bench[] = {
+    {"timer: dispatch", IRQ_TIMER, timer_handler, timer_isr, timer_trigger, IRQ_BENCH_TIMER_CMP},
+    {"uart:  dispatch", IRQ_UART,  uart_handler,  uart_isr,  uart_trigger,  0},
+    {"gpio:  dispatch", IRQ_GPIO,  gpio_handler,  gpio_isr,  gpio_trigger,  0},
+};
+
+// Returns min (low half) and max (high half) latency over IRQ_BENCH_RUNS runs
+static uint32_t irq_bench_run(const irq_bench_t *bench, uint32_t calib) {
+    uint32_t min = 0xFFFF, max = 0;
+    for (int i = 0; i < IRQ_BENCH_RUNS; i++) {
+        irq_done = 0;
+        bench->trigger();
+        while (!irq_done)
+            ;
+        uint32_t lat = irq_cycle - irq_start - calib - bench->offset;
+        if (lat < min) min = lat;
+        if (lat > max) max = lat;
+    }
+    return (max << 16) | min;
+}
+
+static void irq_bench_print(const char *path, uint32_t minmax) {
+    while (*path)
+        putchar(*path++);
+    printf(" min 0x%x max 0x%x", minmax & 0xFFFF, minmax >> 16);
+}
+
+int main() {
+    uart_init();
+
+    // cycles of back-to-back mcycle reads, removed from every measurement
+    uint32_t calib = mcycle32();
+    calib = mcycle32() - calib;
+
+    gpio_pin_set_output(0);
+    gpio_pin_enable(0);
+    gpio_pin_enable(4);
+    gpio_pin_enable_rising_interrupt(4);
+
+    printf("IRQ entry latency [cycles], %x runs:\n", IRQ_BENCH_RUNS);
+    set_mie(1);
+    for (unsigned i = 0; i < sizeof(irq_bench) / sizeof(irq_bench[0]); i++) {
+        const irq_bench_t *bench = &irq_bench[i];
+        uint32_t dispatch, fast;
+
+        irq_register(bench->irq, bench->handler);
+        dispatch = irq_bench_run(bench, calib);
+        irq_set_vector(bench->irq, bench->isr);
+        fast = irq_bench_run(bench, calib);
+        irq_register(bench->irq, 0);
+
+        irq_bench_print(bench->name, dispatch);
+        irq_bench_print(" | fast", fast);
+        printf("\n");
+    }
+    set_mie(0);
+
+    uart_write_flush();
+    return 1;
+}
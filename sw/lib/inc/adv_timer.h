@@ -8,6 +8,12 @@
 #ifndef __TIMER_REGS_H__
 #define __TIMER_REGS_H__
 
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // -----------------------------------------------------------------------------
 // Timer Command Register bits
 // -----------------------------------------------------------------------------
@@ -25,6 +31,32 @@
 #define TIM_CFG_SEL_CLK_SRC (1 << 11)
 #define TIM_CFG_SEL_SAW (1 << 12)
 #define TIM_CFG_PRESC_MASK (0xFF << 16)
+#define TIM_CFG_PRESC(n) (((n) & 0xFF) << 16)
+
+// -----------------------------------------------------------------------------
+// Channel Threshold Register: [15:0] threshold, [18:16] output mode
+// -----------------------------------------------------------------------------
+#define TIM_CH_MODE_SET 0x0    // set on match
+#define TIM_CH_MODE_TOGRST 0x1 // toggle on match, reset at the next
+#define TIM_CH_MODE_SETRST 0x2 // set on match, reset at the next
+#define TIM_CH_MODE_TOG 0x3    // toggle on match
+#define TIM_CH_MODE_RST 0x4    // reset on match
+#define TIM_CH_MODE_TOGSET 0x5 // toggle on match, set at the next
+#define TIM_CH_MODE_RSTSET 0x6 // reset on match, set at the next
+#define TIM_CH_TH(mode, threshold) ((((mode) & 0x7) << 16) | ((threshold) & 0xFFFF))
+
+// -----------------------------------------------------------------------------
+// Register addresses of timer n (0..3)
+// -----------------------------------------------------------------------------
+#define ADV_TIMER_N_TIMERS 4
+#define ADV_TIMER_N_CHANNELS 4
+#define ADV_TIMER_OFFSET_PER_TIMER 0x40
+#define REG_TIM_CMD(n) (REG_TIM0_CMD + (n) * ADV_TIMER_OFFSET_PER_TIMER)
+#define REG_TIM_CFG(n) (REG_TIM0_CFG + (n) * ADV_TIMER_OFFSET_PER_TIMER)
+#define REG_TIM_TH(n) (REG_TIM0_TH + (n) * ADV_TIMER_OFFSET_PER_TIMER)
+#define REG_TIM_CH_TH(n, ch) (REG_TIM0_CH0_TH + (n) * ADV_TIMER_OFFSET_PER_TIMER + (ch) * 4)
+#define REG_TIM_CH_LUT(n, ch) (REG_TIM0_CH0_LUT + (n) * ADV_TIMER_OFFSET_PER_TIMER + (ch) * 4)
+#define REG_TIM_COUNTER(n) (REG_TIM0_COUNTER + (n) * ADV_TIMER_OFFSET_PER_TIMER)
 
 // -----------------------------------------------------------------------------
 // Timer 0 Registers
@@ -99,11 +131,76 @@
 #define REG_TIM2_EN (1 << 2)
 #define REG_TIM3_EN (1 << 3)
 
-void timer0_init(int topvalue);
+// -----------------------------------------------------------------------------
+// Input capture of the wrapper (rtl/adv_timer_wrap)
+// -----------------------------------------------------------------------------
+#define REG_CAP_CFG 0x200    // [4:0] pin, [5] rising, [6] falling, [15:8] irq threshold
+#define REG_CAP_STATUS 0x204 // [7:0] queued entries, [8] overflow (write 1 to clear)
+#define REG_CAP_DATA 0x208   // read pops the oldest entry, 0 (CAP_VALID clear) if empty
+#define REG_CAP_TIME 0x20C   // current timestamp
+#define REG_CAP_FLUSH 0x210
+#define CAP_CFG_RISING (1 << 5)
+#define CAP_CFG_FALLING (1 << 6)
+#define CAP_STATUS_OVERFLOW (1 << 8)
+#define ADV_TIMER_CAP_DEPTH 8 // croc_pkg::AdvTimerCaptureDepth
+
+// Capture entry: valid bit, edge direction and timestamp in system clock cycles (30 bit, wraps)
+#define CAP_VALID(entry) ((entry) >> 31)
+#define CAP_RISING(entry) (((entry) >> 30) & 1)
+#define CAP_TIME(entry) ((entry) & 0x3FFFFFFF)
+#define CAP_DELTA(later, earlier) ((CAP_TIME(later) - CAP_TIME(earlier)) & 0x3FFFFFFF)
+
+// -----------------------------------------------------------------------------
+// Driver for all timers and channels
+// -----------------------------------------------------------------------------
+// Every writable register has a copy in SRAM, so configuration changes are single writes and
+// getters never go over the bus (only the counters are read from the timer). Channel thresholds
+// are staged in the copy and written by adv_timer_commit(), which then sends one TIM_CMD_UPDATE
+// per timer: all channels of a timer switch to their new values in the same period.
+// The copy starts at the reset values and is only valid if all accesses go through this driver.
+
+// Reload the register copy from the timer, e.g. if the core restarted without a timer reset
+void adv_timer_sync(void);
+
+void adv_timer_config(int timer_id, uint32_t cfg);      // TIM_CFG_* bits
+void adv_timer_set_range(int timer_id, int bottomvalue, int topvalue); // both values included
+void adv_timer_set_channel(int timer_id, int ch, int mode, int threshold); // staged
+void adv_timer_set_threshold(int timer_id, int ch, int threshold);         // staged, keeps mode
+void adv_timer_set_lut(int timer_id, int ch, uint32_t lut);
+void adv_timer_commit(int timers_to_update); // write staged channels, TIM_CMD_UPDATE
+
+void adv_timer_clk_enable(int timers_to_en);
+void adv_timer_clk_disable(int timers_to_dis);
 void adv_timer_start(int timer_id);
+void adv_timer_stop(int timer_id);
+void adv_timer_reset(int timer_id);
 
 void adv_timer_enable_event(int timer_id, int sel_channel);
+void adv_timer_disable_event(int timer_id);
 
+int adv_timer_get_counter(int timer_id);
+int adv_timer_get_top_value(int timer_id);
+int adv_timer_get_bottom_value(int timer_id);
+int adv_timer_get_threshold(int timer_id, int ch);
+
+// PWM on channel ch: period of nCycles (timer clock cycles), high for dutyCycle percent of it
+void adv_timer_pwm_init(int timer_id, int ch, int nCycles, int dutyCycle);
+
+// Input capture: timestamps of edges on one GPIO, without polling. The handler is called from
+// IRQ_ADV_TIMER_CAPTURE once threshold (1..ADV_TIMER_CAP_DEPTH) entries are queued and has to
+// read them, threshold 0 or no handler disables the interrupt.
+typedef void (*adv_timer_capture_handler_t)(void);
+void adv_timer_capture_init(int pin, int rising, int falling, int threshold,
+                            adv_timer_capture_handler_t handler);
+void adv_timer_capture_disable(void);
+int adv_timer_capture_level(void);
+int adv_timer_capture_overflow(void); // edges were lost since the last call
+// Pop up to max entries into entries, returns how many were read
+int adv_timer_capture_read(uint32_t *entries, int max);
+uint32_t adv_timer_capture_time(void);
+
+// Timer 0 shortcuts
+void timer0_init(int topvalue);
 void timer0_pwm_init(int nCycles, int dutycycle_value);
 
 int timer0_get_counter();
@@ -112,4 +209,8 @@ int timer0_get_top_value();
 int timer0_get_bottom_value();
 void timer0_set_bottom_top_value(int bottomvalue, int topvalue);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif // __TIMER_REGS_H__
@@ -0,0 +1,63 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+//
+// Driver for the user domain DMA engine (rtl/user_domain/user_dma.sv).
+// One channel, one element is read and then written at a time. Peripheral transfers have no
+// flow control: a transfer into or out of a peripheral FIFO must fit its free space/fill level.
+
+#pragma once
+
+#include <stdint.h>
+#include "config.h"
+
+// Register offsets
+#define DMA_SRC_REG_OFFSET    0x00
+#define DMA_DST_REG_OFFSET    0x04
+#define DMA_LEN_REG_OFFSET    0x08
+#define DMA_CTRL_REG_OFFSET   0x0C
+#define DMA_STATUS_REG_OFFSET 0x10
+
+// Register fields
+#define DMA_CTRL_START_BIT     0
+#define DMA_CTRL_SRC_FIXED_BIT 1 // source is a peripheral register
+#define DMA_CTRL_DST_FIXED_BIT 2 // destination is a peripheral register
+#define DMA_CTRL_SIZE_BIT      3 // 4:3, element size is 1 << SIZE bytes
+#define DMA_CTRL_IRQ_EN_BIT    5
+
+#define DMA_STATUS_BUSY_BIT  0
+#define DMA_STATUS_DONE_BIT  1 // write 1 to clear
+#define DMA_STATUS_ERROR_BIT 2 // write 1 to clear
+
+// Transfer modes for dma_start()
+#define DMA_MEM_TO_MEM    0
+#define DMA_MEM_TO_PERIPH (1 << DMA_CTRL_DST_FIXED_BIT)
+#define DMA_PERIPH_TO_MEM (1 << DMA_CTRL_SRC_FIXED_BIT)
+
+// Element sizes for dma_start()
+#define DMA_SIZE_BYTE (0 << DMA_CTRL_SIZE_BIT)
+#define DMA_SIZE_HALF (1 << DMA_CTRL_SIZE_BIT)
+#define DMA_SIZE_WORD (2 << DMA_CTRL_SIZE_BIT)
+
+// Called from the DMA interrupt with the status of the finished transfer (DONE/ERROR bits)
+typedef void (*dma_callback_t)(uint32_t status);
+
+// Start a transfer of len bytes (a multiple of the element size), returns immediately.
+// mode is one of DMA_MEM_TO_MEM, DMA_MEM_TO_PERIPH or DMA_PERIPH_TO_MEM, size one of DMA_SIZE_*.
+// Does nothing while a transfer is running, the registers may be set up again after dma_busy().
+void dma_start(volatile void *dst, const volatile void *src, uint32_t len, uint32_t mode,
+               uint32_t size);
+
+// Returns 1 while a transfer is running
+int dma_busy(void);
+
+// Wait for the running transfer, returns 0 on success and -1 on a bus error
+int dma_wait(void);
+
+// Blocking mem-to-mem copy, uses word transfers if dst, src and len are word aligned
+void dma_memcpy(void *dst, const void *src, uint32_t len);
+
+// Raise IRQ_DMA at the end of every transfer and call callback from it (NULL disables it)
+void dma_set_callback(dma_callback_t callback);
@@ -9,6 +9,10 @@
 #include <stdint.h>
 #include "config.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 
 #define GPIO_DIR_REG_OFFSET           0x000
 #define GPIO_EN_REG_OFFSET            0x080
@@ -19,6 +23,18 @@
 #define GPIO_INTRPT_STATUS_REG_OFFSET 0x300
 #define GPIO_INTRPT_EDGE_REG_OFFSET   0x380
 
+// Pattern stream (rtl/gpio/gpio_stream.sv)
+#define GPIO_STREAM_CTRL_REG_OFFSET   0x400 // [0] play, [1] irq enable, [15:8] low watermark
+#define GPIO_STREAM_DIV_REG_OFFSET    0x404 // output period in clock cycles minus one
+#define GPIO_STREAM_MASK_REG_OFFSET   0x408
+#define GPIO_STREAM_STATUS_REG_OFFSET 0x40C // [7:0] queued words, [8] underrun, [9] overflow
+#define GPIO_STREAM_DATA_REG_OFFSET   0x410
+#define GPIO_STREAM_CTRL_PLAY         (1 << 0)
+#define GPIO_STREAM_CTRL_IRQ_EN       (1 << 1)
+#define GPIO_STREAM_STATUS_UNDERRUN   (1 << 8)
+#define GPIO_STREAM_STATUS_OVERFLOW   (1 << 9)
+#define GPIO_STREAM_DEPTH             8
+
 // functions applying to all 32 GPIOs with mask
 // a 1 in the mask applies action to this GPIO pin
 // LSB is considered GPIO number 0 
@@ -50,3 +66,19 @@ void gpio_pin_enable_rising_interrupt(uint8_t gpio_pin);
 void gpio_pin_enable_falling_interrupt(uint8_t gpio_pin);
 void gpio_pin_disable_interrupts(uint8_t gpio_pin);
 uint8_t gpio_pin_get_interrupt_status(uint8_t gpio_pin);
+
+// pattern stream: plays words on the GPIOs in mask (enabled outputs), one every `period`
+// clock cycles. Words are queued in a small FIFO, queue some before gpio_stream_start().
+void gpio_stream_init(uint32_t mask, uint32_t period);
+void gpio_stream_start(void);
+void gpio_stream_stop(void);
+// queue words, waits for space in the FIFO
+void gpio_stream_write(const uint32_t *words, uint32_t count);
+// play a whole table from the low watermark interrupt, returns immediately
+void gpio_stream_play(const uint32_t *words, uint32_t count);
+int gpio_stream_busy(void);     // gpio_stream_play() has words left to queue
+int gpio_stream_underrun(void); // the FIFO ran empty since the last call
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,65 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Interrupt ids, equal to the mcause code and the mie/mip bit of the source.
+// The fast interrupt lines (irq_fast_i) are assigned in croc_domain.sv.
+#define IRQ_TIMER       7                  // timer_unit irq_lo (irq_timer_i)
+#define IRQ_FAST(line)  (16 + (line))      // irq_fast_i[line]
+#define IRQ_TIMER_HI    IRQ_FAST(0)        // timer_unit irq_hi
+#define IRQ_UART        IRQ_FAST(1)
+#define IRQ_GPIO        IRQ_FAST(2)
+#define IRQ_EXTERNAL(n) IRQ_FAST(3 + (n))  // user domain interrupts_o[n], n < 4
+#define IRQ_DMA         IRQ_EXTERNAL(0)    // user domain DMA (user_pkg::UserDmaIrq)
+#define IRQ_ADV_TIMER   IRQ_FAST(7)        // adv timer 0 event 0
+#define IRQ_PULSER      IRQ_FAST(8)        // pulser train completed (pulser_wrap)
+#define IRQ_ADV_TIMER_CAPTURE IRQ_FAST(9)  // adv timer capture FIFO at threshold (adv_timer_wrap)
+#define IRQ_GPIO_STREAM IRQ_FAST(10)       // GPIO pattern stream at low watermark (gpio_stream)
+#define IRQ_NUM         32
+
+// Handlers for irq_register() are normal C functions. crt0 saves the caller-saved
+// registers and looks the handler up by mcause (about 40 instructions round trip).
+typedef void (*irq_handler_t)(void);
+
+// Fast-path handlers for irq_set_vector() are entered straight from the vector table.
+// The compiler saves only the registers the handler uses and returns with mret.
+#define IRQ_FAST_HANDLER __attribute__((interrupt("machine")))
+
+// Disable interrupts (mstatus.MIE), returns the previous state for irq_unlock()
+static inline uint32_t irq_lock(void) {
+    uint32_t mstatus;
+    asm volatile("csrrci %0, mstatus, 8" : "=r"(mstatus)::"memory");
+    return mstatus & 8;
+}
+
+// Runs the timers that expired while interrupts were disabled, see timer.h
+void timer_poll_locked(void);
+
+static inline void irq_unlock(uint32_t key) {
+    if (key) {
+        timer_poll_locked();
+        asm volatile("csrsi mstatus, 8" ::: "memory");
+    }
+}
+
+// Install a handler for an interrupt id and enable it in mie (NULL disables it).
+// Also restores the default dispatcher if a fast-path handler was set with irq_set_vector().
+void irq_register(int irq, irq_handler_t handler);
+
+// Point the vector table entry of an interrupt id directly at a IRQ_FAST_HANDLER function
+// and enable it in mie (NULL disables it and restores the default dispatcher).
+void irq_set_vector(int irq, void (*isr)(void));
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,49 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#pragma once
+
+#include <stdint.h>
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Deferred logging
+// LOG(fmt, ...) does not format anything on the target. The format string goes into the .log_fmt
+// section, which is kept in the ELF but not loaded (link.ld), and only a binary record is sent:
+//   [0]   0x80 | number of arguments
+//   [2:1] string id, the address in .log_fmt (little endian)
+//   then  4 bytes per argument (little endian)
+// sw/scripts/log_decode.py formats the records against the ELF, the testbench UART monitor
+// calls it for every record. printf output can be mixed in, it never has bit 7 set.
+// Arguments are sent as raw 32-bit words, so the format string may use %d, %u, %x and %c (with
+// width and zero padding, as printf) but not %s.
+// With LOG_RING_SIZE != 0 (config.h) the records are buffered in SRAM until log_flush(), which
+// keeps the UART out of timing critical code and makes LOG() safe in interrupt handlers.
+
+#define LOG_MAX_ARGS 7
+#define LOG_RECORD_FLAG 0x80
+
+#define LOG(fmt, ...)                                                                             \
+    do {                                                                                          \
+        static const char __log_fmt[] __attribute__((section(".log_fmt"), used)) = fmt;           \
+        const uint32_t __log_args[] = {0, ##__VA_ARGS__};                                         \
+        _Static_assert(sizeof(__log_args) <= (LOG_MAX_ARGS + 1) * 4, "too many LOG arguments");  \
+        log_record((uint32_t)__log_fmt, __log_args + 1, sizeof(__log_args) / 4 - 1);              \
+    } while (0)
+
+// emit one record, use LOG() instead
+void log_record(uint32_t id, const uint32_t *args, uint32_t nargs);
+
+// write the records buffered in the SRAM ring (LOG_RING_SIZE) to the UART,
+// returns the number of records dropped because the ring was full
+uint32_t log_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
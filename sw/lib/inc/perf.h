@@ -0,0 +1,79 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+//
+// Core performance counters. mcycle and minstret always exist, the event counters need the
+// hardware built with HPM_COUNTERS=N (top-level Makefile), missing counters read as zero.
+// On cve2 the event of mhpmcounterN is fixed to event N (mhpmeventN is read-only), so the
+// counters are configured by enabling/inhibiting them through mcountinhibit.
+
+#pragma once
+
+#include <stdint.h>
+
+// Counter/event ids, also the bit in mcountinhibit
+#define PERF_CYCLES         0
+#define PERF_INSTRET        2
+#define PERF_EVENT_LSU_WAIT 3  // cycles waiting for data memory (load/store stalls)
+#define PERF_EVENT_IF_WAIT  4  // cycles waiting for instruction fetches
+#define PERF_EVENT_LOAD     5
+#define PERF_EVENT_STORE    6
+#define PERF_EVENT_JUMP     7  // unconditional jumps
+#define PERF_EVENT_BRANCH   8  // conditional branches
+#define PERF_EVENT_TAKEN    9  // taken conditional branches
+#define PERF_EVENT_COMP     10 // compressed instructions
+#define PERF_EVENT_MUL_WAIT 11 // cycles waiting for multiply (or wfi)
+#define PERF_EVENT_DIV_WAIT 12 // cycles waiting for divide
+#define PERF_EVENT_FIRST    PERF_EVENT_LSU_WAIT
+#define PERF_EVENT_NUM      10
+
+#define PERF_CSR_MCOUNTER(n)  (0xB00 + (n)) // mcycle, minstret, mhpmcounterN
+#define PERF_CSR_MCOUNTERH(n) (0xB80 + (n))
+#define PERF_CSR_MHPMEVENT(n) (0x320 + (n))
+
+#define PERF_CSR_READ(csr) \
+    ({ \
+        uint32_t __v; \
+        asm volatile("csrr %0, %1" : "=r"(__v) : "i"(csr) : "memory"); \
+        __v; \
+    })
+
+// Read a 64-bit counter atomically (hi/lo/hi), n must be a constant
+#define PERF_READ(n) \
+    ({ \
+        uint32_t __hi, __lo, __hi2 = PERF_CSR_READ(PERF_CSR_MCOUNTERH(n)); \
+        do { \
+            __hi  = __hi2; \
+            __lo  = PERF_CSR_READ(PERF_CSR_MCOUNTER(n)); \
+            __hi2 = PERF_CSR_READ(PERF_CSR_MCOUNTERH(n)); \
+        } while (__hi != __hi2); \
+        ((uint64_t)__hi << 32) | __lo; \
+    })
+
+typedef struct {
+    uint64_t cycles;
+    uint64_t instret;
+    uint64_t event[PERF_EVENT_NUM]; // indexed by PERF_EVENT_* - PERF_EVENT_FIRST
+} perf_t;
+
+// Bracket a region: afterwards p holds the counter increments within it
+#define PERF_BEGIN(p) perf_snapshot(&(p))
+#define PERF_END(p)   perf_delta(&(p))
+
+// start/stop the counters selected by mask (bits are counter ids, see above)
+void perf_enable(uint32_t mask);
+void perf_disable(uint32_t mask);
+
+// event counted by mhpmcounterN, 0 if the counter does not exist
+uint32_t perf_get_event(int counter);
+
+// p = current counter values
+void perf_snapshot(perf_t *p);
+
+// p = current counter values - p
+void perf_delta(perf_t *p);
+
+// print cycles, instructions, CPI and the event counts of p over UART
+void perf_report(const char *name, const perf_t *p);
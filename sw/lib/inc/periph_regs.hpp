@@ -0,0 +1,152 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#pragma once
+
+#include "reg.hpp"
+#include "pulser_core_regs.hpp"    // generated, see sw/scripts/gen_reg_hpp.py
+#include "pulser_general_regs.hpp" // generated
+#include "pulser.h"
+#include "adv_timer.h"
+#include "gpio.h"
+#include "uart.h"
+#include "config.h"
+
+// Register maps for C++ firmware (reg.hpp), the offsets come from the C driver headers.
+// Example: Pulser<0>::CfgCnt::write(Pulser<0>::CfgCnt::F1::val(8) | Pulser<0>::CfgCnt::F2::val(5));
+
+// -----------------------------------------------------------------------------
+// Pulser (rtl/pulser_wrap)
+// -----------------------------------------------------------------------------
+template <unsigned Id>
+struct Pulser : PulserCoreRegs<PULSER_BASE_ADDR + Id * PULSER_OFFSET_PER_ID> {
+    static_assert(Id < N_PULSERS, "no such pulser");
+    static constexpr uint32_t mask = 1u << Id;
+};
+
+// Cfg::En is mirrored in SRAM by pulser_en()/pulser_dis(), use those when the C driver is linked
+struct PulserGeneral : PulserGeneralRegs<PULSER_BASE_ADDR + N_PULSERS * PULSER_OFFSET_PER_ID> {
+    // completion interrupt of the wrapper, one bit per instance
+    using IrqPending = reg::Reg<PULSER_BASE_ADDR + PULSER_IRQ_PENDING_REG_OFFSET>;
+    using IrqMask = reg::Reg<PULSER_BASE_ADDR + PULSER_IRQ_MASK_REG_OFFSET>;
+};
+
+// -----------------------------------------------------------------------------
+// Advanced timer (rtl/adv_timer_wrap)
+// -----------------------------------------------------------------------------
+template <unsigned N>
+struct AdvTimer {
+    static_assert(N < ADV_TIMER_N_TIMERS, "no such timer");
+
+    static constexpr uint32_t cmd = ADV_TIMER_BASE_ADDR + REG_TIM_CMD(N);
+    struct Cmd : reg::Reg<cmd> {
+        using Start = reg::Field<cmd, 0>;
+        using Stop = reg::Field<cmd, 1>;
+        using Update = reg::Field<cmd, 2>;
+        using Rst = reg::Field<cmd, 3>;
+        using Arm = reg::Field<cmd, 4>;
+    };
+
+    static constexpr uint32_t cfg = ADV_TIMER_BASE_ADDR + REG_TIM_CFG(N);
+    struct Cfg : reg::Reg<cfg> {
+        using InSel = reg::Field<cfg, 0, 8>;
+        using InMode = reg::Field<cfg, 8, 3>;
+        using SelClkSrc = reg::Field<cfg, 11>;
+        using SelSaw = reg::Field<cfg, 12>;
+        using Presc = reg::Field<cfg, 16, 8>;
+    };
+
+    static constexpr uint32_t th = ADV_TIMER_BASE_ADDR + REG_TIM_TH(N);
+    struct Th : reg::Reg<th> {
+        using Bottom = reg::Field<th, 0, 16>;
+        using Top = reg::Field<th, 16, 16>;
+    };
+
+    template <unsigned Ch>
+    struct ChTh : reg::Reg<ADV_TIMER_BASE_ADDR + REG_TIM_CH_TH(N, Ch)> {
+        static_assert(Ch < ADV_TIMER_N_CHANNELS, "no such channel");
+        using Threshold = reg::Field<ADV_TIMER_BASE_ADDR + REG_TIM_CH_TH(N, Ch), 0, 16>;
+        using Mode = reg::Field<ADV_TIMER_BASE_ADDR + REG_TIM_CH_TH(N, Ch), 16, 3>; // TIM_CH_MODE_*
+    };
+
+    template <unsigned Ch>
+    using ChLut = reg::Reg<ADV_TIMER_BASE_ADDR + REG_TIM_CH_LUT(N, Ch)>;
+    using Counter = reg::Reg<ADV_TIMER_BASE_ADDR + REG_TIM_COUNTER(N)>;
+};
+
+struct AdvTimerGlobal {
+    static constexpr uint32_t event_cfg = ADV_TIMER_BASE_ADDR + REG_EVENT_CFG;
+    struct EventCfg : reg::Reg<event_cfg> {
+        using Sel0 = reg::Field<event_cfg, 0, 4>;
+        using Sel1 = reg::Field<event_cfg, 4, 4>;
+        using Sel2 = reg::Field<event_cfg, 8, 4>;
+        using Sel3 = reg::Field<event_cfg, 12, 4>;
+        using En = reg::Field<event_cfg, 16, 4>;
+    };
+
+    static constexpr uint32_t ch_en = ADV_TIMER_BASE_ADDR + REG_CH_EN;
+    struct ChEn : reg::Reg<ch_en> {
+        using ClkEn = reg::Field<ch_en, 0, ADV_TIMER_N_TIMERS>;
+    };
+};
+
+// -----------------------------------------------------------------------------
+// GPIO (rtl/gpio)
+// -----------------------------------------------------------------------------
+struct Gpio {
+    using Dir = reg::Reg<GPIO_BASE_ADDR + GPIO_DIR_REG_OFFSET>;
+    using En = reg::Reg<GPIO_BASE_ADDR + GPIO_EN_REG_OFFSET>;
+    using In = reg::Reg<GPIO_BASE_ADDR + GPIO_IN_REG_OFFSET>;
+    using Out = reg::Reg<GPIO_BASE_ADDR + GPIO_OUT_REG_OFFSET>;
+    using Toggle = reg::Reg<GPIO_BASE_ADDR + GPIO_TOGGLE_REG_OFFSET>;
+    using IntrptEn = reg::Reg<GPIO_BASE_ADDR + GPIO_INTRPT_EN_REG_OFFSET>;
+    using IntrptStatus = reg::Reg<GPIO_BASE_ADDR + GPIO_INTRPT_STATUS_REG_OFFSET>;
+    using IntrptEdge = reg::Reg<GPIO_BASE_ADDR + GPIO_INTRPT_EDGE_REG_OFFSET>;
+
+    static constexpr uint32_t stream_ctrl = GPIO_BASE_ADDR + GPIO_STREAM_CTRL_REG_OFFSET;
+    struct StreamCtrl : reg::Reg<stream_ctrl> {
+        using Play = reg::Field<stream_ctrl, 0>;
+        using IrqEn = reg::Field<stream_ctrl, 1>;
+        using Watermark = reg::Field<stream_ctrl, 8, 8>;
+    };
+
+    using StreamDiv = reg::Reg<GPIO_BASE_ADDR + GPIO_STREAM_DIV_REG_OFFSET>;
+    using StreamMask = reg::Reg<GPIO_BASE_ADDR + GPIO_STREAM_MASK_REG_OFFSET>;
+
+    static constexpr uint32_t stream_status = GPIO_BASE_ADDR + GPIO_STREAM_STATUS_REG_OFFSET;
+    struct StreamStatus : reg::Reg<stream_status> {
+        using Level = reg::Field<stream_status, 0, 8>;
+        using Underrun = reg::Field<stream_status, 8>;
+        using Overflow = reg::Field<stream_status, 9>;
+    };
+
+    using StreamData = reg::Reg<GPIO_BASE_ADDR + GPIO_STREAM_DATA_REG_OFFSET>;
+};
+
+// -----------------------------------------------------------------------------
+// UART, byte registers
+// -----------------------------------------------------------------------------
+struct Uart {
+    using Rbr = reg::Reg<UART_BASE_ADDR + UART_RBR_REG_OFFSET, uint8_t>;
+    using Thr = reg::Reg<UART_BASE_ADDR + UART_THR_REG_OFFSET, uint8_t>;
+
+    static constexpr uint32_t ier = UART_BASE_ADDR + UART_INTR_ENABLE_REG_OFFSET;
+    struct IntrEnable : reg::Reg<ier, uint8_t> {
+        using DataReady = reg::Field<ier, UART_INTR_ENABLE_DATA_READY_BIT, 1, uint8_t>;
+        using ThrEmpty = reg::Field<ier, UART_INTR_ENABLE_THR_EMPTY_BIT, 1, uint8_t>;
+    };
+
+    using FifoControl = reg::Reg<UART_BASE_ADDR + UART_FIFO_CONTROL_REG_OFFSET, uint8_t>;
+    using LineControl = reg::Reg<UART_BASE_ADDR + UART_LINE_CONTROL_REG_OFFSET, uint8_t>;
+    using ModemControl = reg::Reg<UART_BASE_ADDR + UART_MODEM_CONTROL_REG_OFFSET, uint8_t>;
+
+    static constexpr uint32_t lsr = UART_BASE_ADDR + UART_LINE_STATUS_REG_OFFSET;
+    struct LineStatus : reg::Reg<lsr, uint8_t> {
+        using DataReady = reg::Field<lsr, UART_LINE_STATUS_DATA_READY_BIT, 1, uint8_t>;
+        using ThrEmpty = reg::Field<lsr, UART_LINE_STATUS_THR_EMPTY_BIT, 1, uint8_t>;
+        using TmitEmpty = reg::Field<lsr, UART_LINE_STATUS_TMIT_EMPTY_BIT, 1, uint8_t>;
+    };
+};
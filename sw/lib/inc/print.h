@@ -8,7 +8,28 @@
 
 #include <stdarg.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 extern void putchar(char);
 
-// simple printf with support for %x formatter but no others
-void printf(char *fmt, ...);
+#include <stdint.h>
+
+// printf with %d, %u, %x (upper case digits), %c, %s and %%, an optional field width and
+// zero padding (e.g. %08x, %4d). No division is used, so it is cheap without RV32M.
+// The line is assembled in a PRINT_BUF_SIZE buffer and written with one uart_write_str() call.
+void printf(const char *fmt, ...);
+
+// same formatting into buf, truncated to size-1 characters and terminated, returns the length
+uint32_t format_str(char *buf, uint32_t size, const char *fmt, ...);
+
+// format num as hex digits (most significant first, no terminator), returns the length
+uint8_t format_hex32(char *buffer, uint32_t num);
+
+// format num as decimal digits (most significant first, no terminator), returns the length
+uint8_t format_dec32(char *buffer, uint32_t num);
+
+#ifdef __cplusplus
+}
+#endif
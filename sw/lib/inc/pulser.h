@@ -1,6 +1,7 @@
 #ifndef PULSER_H
 #define PULSER_H
 
+#include <stdint.h>
 #include "pulser_core_reg_defs.h" // autogenerated registers
 #include "pulser_general_reg_defs.h" // autogenerated registers
 
@@ -12,8 +13,28 @@ extern "C"
 #define PULSER_OFFSET_PER_ID 0x20
 #define N_PULSERS 8
 
+// Configuration queue of the pulser wrapper (rtl/pulser_wrap), offsets from PULSER_BASE_ADDR
+#define PULSER_QUEUE_STAGE_REG_OFFSET 0x200 // F1, F2, CNT, CTRL_OUT of the next entry
+#define PULSER_QUEUE_PUSH_REG_OFFSET  0x210 // mask of instances to push the staged entry to
+#define PULSER_QUEUE_FLUSH_REG_OFFSET 0x214
+#define PULSER_QUEUE_FULL_REG_OFFSET  0x218
+#define PULSER_QUEUE_EMPTY_REG_OFFSET 0x21C
+#define PULSER_QUEUE_LEVEL_REG_OFFSET 0x220 // + 4 * id
+#define PULSER_QUEUE_DEPTH 2                // croc_pkg::PulserQueueDepth
+
+// Completion interrupt of the pulser wrapper, one bit per instance
+#define PULSER_IRQ_PENDING_REG_OFFSET 0x108 // write 1 to clear
+#define PULSER_IRQ_MASK_REG_OFFSET    0x10C
+
+// Trigger crossbar of the pulser wrapper: rising edges of a source start/stop instances in hardware
+#define PULSER_TRIG_ROUTE_REG_OFFSET 0x300 // + 4 * source, [15:0] start mask, [31:16] stop mask
+#define PULSER_TRIG_GPIO_REG_OFFSET  0x320 // byte per GPIO source: [4:0] pin, [5] rise, [6] fall
+#define PULSER_TRIG_SRC_ADV_EVENT(n) (n)       // adv timer event n (0..3), see adv_timer_enable_event()
+#define PULSER_TRIG_SRC_GPIO(k)      (4 + (k)) // GPIO edge source k (0..1), see pulser_trigger_gpio()
+#define PULSER_TRIG_NUM_SRC 6
+
     //------------------------------------------------------------------------------
-    // Bitfield helper type and inline functions (declarations only, no implementation)
+    // Bitfield helper type and inline functions
     //------------------------------------------------------------------------------
 
     typedef struct
@@ -22,8 +43,18 @@ extern "C"
         uint8_t index; // Bit position (offset) of the field
     } bitfield_field32_t;
 
-    uint32_t bitfield_get_field32(bitfield_field32_t field, uint32_t reg);
-    uint32_t bitfield_set_field32(bitfield_field32_t field, uint32_t reg, uint32_t value);
+    // Inline so constant fields fold into shift/mask (bext/andn with RV32B)
+    static inline uint32_t bitfield_get_field32(bitfield_field32_t field, uint32_t reg)
+    {
+        return (reg >> field.index) & field.mask;
+    }
+
+    static inline uint32_t bitfield_set_field32(bitfield_field32_t field, uint32_t reg, uint32_t value)
+    {
+        reg &= ~(field.mask << field.index);
+        reg |= ((value & field.mask) << field.index);
+        return reg;
+    }
 
     //------------------------------------------------------------------------------
     // Pulser types
@@ -42,6 +73,31 @@ extern "C"
         int idle_high;
     } pulser_settings_t;
 
+    // Register image of one instance: the CFG_F1, CFG_F2, CFG_CNT and CTRL_OUT words as they are
+    // written to the hardware, so loading a waveform is four stores without any field packing.
+    // Build them at compile time with PULSER_IMAGE() or at runtime with pulser_image_make().
+    typedef struct
+    {
+        uint32_t f1;
+        uint32_t f2;
+        uint32_t cnt;
+        uint32_t ctrl_out;
+    } pulser_image_t;
+
+// Constant initializer of a pulser_image_t, arguments in the order of pulser_settings_t
+#define PULSER_FIELD(reg, field, value) \
+    (((uint32_t)(value) & PULSER_CORE_##reg##_##field##_MASK) << PULSER_CORE_##reg##_##field##_OFFSET)
+#define PULSER_IMAGE(f1_end, f1_switch, f2_end, f2_switch, f1_count, f2_count, stop_count,      \
+                     invert_out, idle_high)                                                     \
+    {                                                                                           \
+        PULSER_FIELD(CFG_F1, ENDVAL, f1_end) | PULSER_FIELD(CFG_F1, SWITCHVAL, f1_switch),      \
+        PULSER_FIELD(CFG_F2, ENDVAL, f2_end) | PULSER_FIELD(CFG_F2, SWITCHVAL, f2_switch),      \
+        PULSER_FIELD(CFG_CNT, F1, f1_count) | PULSER_FIELD(CFG_CNT, F2, f2_count) |             \
+            PULSER_FIELD(CFG_CNT, CNT_STOP, stop_count),                                        \
+        ((invert_out) ? 1u << PULSER_CORE_CTRL_OUT_INVERT_OUT_BIT : 0) |                        \
+            ((idle_high) ? 1u << PULSER_CORE_CTRL_OUT_IDLE_OUT_BIT : 0)                         \
+    }
+
     typedef enum
     {
         IDLE = 0,
@@ -63,18 +119,49 @@ extern "C"
         PULSER_7 = 7
     } pulser_id_t;
 
+    // Called from IRQ_PULSER with the instances (bit per id) that completed a train
+    typedef void (*pulser_done_handler_t)(uint32_t done_mask);
+
     //------------------------------------------------------------------------------
     // Pulser function prototypes
     //------------------------------------------------------------------------------
 
     void pulser_set_values(pulser_id_t id, const pulser_settings_t *settings);
     void pulser_config(pulser_id_t id, const pulser_settings_t *settings);
+    // Pack settings into an image once, e.g. for waveforms that are computed at runtime
+    void pulser_image_make(pulser_image_t *image, const pulser_settings_t *settings);
+    // Write the images to the instances in pulsers_to_load, images are packed: images[0] goes to
+    // the lowest instance in the mask, images[1] to the next one and so on
+    void pulser_load_images(const pulser_image_t *images, uint32_t pulsers_to_load);
+    // The enable mask is kept in a copy in SRAM, so these do not read the bus. Only change
+    // PULSER_GENERAL_CFG through them.
     void pulser_en(int pulser_to_en);
     void pulser_dis(int pulser_to_dis);
     void pulser_disable_all_after_done(void);
     void pulser_start(int pulser_to_start);
     void pulser_stop(int pulser_to_stop);
 
+    // Queue a waveform, it starts as soon as the instance is IDLE or DONE (and enabled), so
+    // queued trains follow each other without software in between. Returns -1 if the queue is full.
+    // The gap between trains is a few bus transactions and grows with the number of running
+    // instances and the pulser accesses of the CPU, see rtl/pulser_wrap/pulser_wrap.sv.
+    int pulser_enqueue(pulser_id_t id, const pulser_settings_t *settings);
+    int pulser_queue_level(pulser_id_t id);
+    void pulser_queue_flush(int pulsers_to_flush);
+
+    // Call handler whenever a train of one of the given instances completes (DONE), instead of
+    // polling the status registers. pulser_irq_disable() masks instances again.
+    void pulser_irq_enable(int pulsers_to_irq, pulser_done_handler_t handler);
+    void pulser_irq_disable(int pulsers_to_mask);
+    uint32_t pulser_irq_pending(void);
+    void pulser_irq_clear(uint32_t done_mask);
+
+    // Start/stop instances in hardware on a trigger source (PULSER_TRIG_SRC_*), a few cycles after
+    // the event without software in between. Empty masks disconnect the source.
+    void pulser_trigger_route(int src, int pulsers_to_start, int pulsers_to_stop);
+    // Select pin and edges of GPIO trigger source k (0..1)
+    void pulser_trigger_gpio(int k, int pin, int rising, int falling);
+
     void pulser_set_f1_end_switch(pulser_id_t id, int endvalue, int switchvalue);
     void pulser_set_f2_end_switch(pulser_id_t id, int endvalue, int switchvalue);
     void pulser_set_f1_f2_stop_count(pulser_id_t id, int n_f1, int n_f2, int n_stop);
@@ -84,6 +171,7 @@ extern "C"
     int pulser_read_f2_end(pulser_id_t id);
     int pulser_read_f2_switch(pulser_id_t id);
     int pulser_read_count(pulser_id_t id);
+    int pulser_read_ctrl_out(pulser_id_t id);
     int pulser_read_status(pulser_id_t id);
     int pulser_ready(pulser_id_t id);
     state_pulser_t get_pulser_fsm_state(pulser_id_t id);
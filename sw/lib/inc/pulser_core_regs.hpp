@@ -0,0 +1,39 @@
+// Generated by sw/scripts/gen_reg_hpp.py from pulser_core_reg_defs.h, do not edit
+
+#pragma once
+
+#include "reg.hpp"
+
+template <uint32_t Base>
+struct PulserCoreRegs {
+    // Phase F1 configuration: end and switch points
+    struct CfgF1 : reg::Reg<Base + 0x0> {
+        using Switchval = reg::Field<Base + 0x0, 0, 16>;
+        using Endval = reg::Field<Base + 0x0, 16, 16>;
+    };
+
+    // Phase F2 configuration: end and switch points
+    struct CfgF2 : reg::Reg<Base + 0x4> {
+        using Switchval = reg::Field<Base + 0x4, 0, 16>;
+        using Endval = reg::Field<Base + 0x4, 16, 16>;
+    };
+
+    // Configure number of pulses for each phase
+    struct CfgCnt : reg::Reg<Base + 0x8> {
+        using F1 = reg::Field<Base + 0x8, 0, 8>;
+        using F2 = reg::Field<Base + 0x8, 8, 8>;
+        using CntStop = reg::Field<Base + 0x8, 16, 8>;
+    };
+
+    // Read state of pulser
+    struct Status : reg::Reg<Base + 0xc> {
+        using Ready = reg::Field<Base + 0xc, 0, 1>;
+        using State = reg::Field<Base + 0xc, 1, 3>;
+    };
+
+    // Set idle state of pulser and if pulse phase should be inverted
+    struct CtrlOut : reg::Reg<Base + 0x10> {
+        using InvertOut = reg::Field<Base + 0x10, 0, 1>;
+        using IdleOut = reg::Field<Base + 0x10, 1, 1>;
+    };
+};
@@ -0,0 +1,19 @@
+// Generated by sw/scripts/gen_reg_hpp.py from pulser_general_reg_defs.h, do not edit
+
+#pragma once
+
+#include "reg.hpp"
+
+template <uint32_t Base>
+struct PulserGeneralRegs {
+    // Start and Stop the pulser. No registers generated, commands handled in pulser.
+    struct Ctrl : reg::Reg<Base + 0x0> {
+        using Start = reg::Field<Base + 0x0, 0, 16>;
+        using Stop = reg::Field<Base + 0x0, 16, 16>;
+    };
+
+    // Set global configs of Pulsers. Currently only enable is active
+    struct Cfg : reg::Reg<Base + 0x4> {
+        using En = reg::Field<Base + 0x4, 0, 16>;
+    };
+};
@@ -0,0 +1,78 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#pragma once
+
+#include <stdint.h>
+
+// Register access templates for C++ firmware
+// Addresses, offsets and widths are template arguments, so masks and shifts are computed by the
+// compiler. Field values of one register are combined with | into a constexpr Bits value:
+//   Reg::write(F1::val(3) | F2::val(5));   // one constant store
+//   Reg::modify(F1::val(n));               // read-modify-write of F1 only
+// Register maps of the peripherals are in periph_regs.hpp.
+
+namespace reg {
+
+template <uint32_t Addr, unsigned Off, unsigned Width, typename T>
+struct Field;
+
+// Field values and their mask, tied to the register address so fields of different registers
+// cannot be combined
+template <uint32_t Addr>
+struct Bits {
+    uint32_t value;
+    uint32_t mask;
+
+    constexpr Bits operator|(Bits other) const {
+        return {value | other.value, mask | other.mask};
+    }
+};
+
+// T is the access width, e.g. uint8_t for the UART registers
+template <uint32_t Addr, typename T = uint32_t>
+struct Reg {
+    static constexpr uint32_t addr = Addr;
+
+    template <unsigned Off, unsigned Width = 1>
+    using Field = ::reg::Field<Addr, Off, Width, T>;
+
+    static volatile T &ref() {
+        return *reinterpret_cast<volatile T *>(Addr);
+    }
+    static T read() {
+        return ref();
+    }
+    static void write(T value) {
+        ref() = value;
+    }
+    // fields that are not in bits are written as 0
+    static void write(Bits<Addr> bits) {
+        ref() = bits.value;
+    }
+    static void modify(Bits<Addr> bits) {
+        ref() = (ref() & ~bits.mask) | bits.value;
+    }
+};
+
+template <uint32_t Addr, unsigned Off, unsigned Width = 1, typename T = uint32_t>
+struct Field {
+    static_assert(Width > 0 && Off + Width <= 8 * sizeof(T), "field outside of the register");
+
+    static constexpr uint32_t mask = (0xFFFFFFFFu >> (32 - Width)) << Off;
+
+    static constexpr Bits<Addr> val(uint32_t value) {
+        return {(value << Off) & mask, mask};
+    }
+    static uint32_t read() {
+        return (Reg<Addr, T>::read() & mask) >> Off;
+    }
+    static void write(uint32_t value) {
+        Reg<Addr, T>::modify(val(value));
+    }
+};
+
+} // namespace reg
@@ -0,0 +1,27 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Freestanding string functions. memcpy, memset and memcmp are RV32I assembly (memops.S) with
+// word accesses for equally aligned buffers, the compiler also calls them for struct copies.
+void *memcpy(void *dst, const void *src, size_t n);
+void *memset(void *dst, int c, size_t n);
+int memcmp(const void *a, const void *b, size_t n);
+void *memmove(void *dst, const void *src, size_t n);
+
+size_t strlen(const char *s);
+int strcmp(const char *a, const char *b);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,98 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#pragma once
+
+#include <stdint.h>
+#include "timer.h"
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Cooperative tasks
+// A task is a stackless coroutine (protothread): task_run() calls its function over and over and
+// the TASK_* macros jump back to the wait it returned from (a switch on the line number). All tasks
+// share the one stack, so locals do not survive a wait: keep state in *arg or in statics, and do
+// not put a TASK_* wait inside a switch statement.
+// The task table is static (TASK_MAX slots, config.h), there is no heap.
+// Tasks run with interrupts disabled, task_run() serves them in between rounds and sleeps in wfi
+// while every task waits. Interrupt handlers and timers wake tasks with task_signal().
+// Tasks must not block: no printf, uart_write_flush or timer_sleep_us, use uart_write_async and
+// TASK_SLEEP_US instead.
+
+// task function return values
+#define TASK_WAITING 0
+#define TASK_YIELDED 1
+#define TASK_EXITED  2
+
+#define TASK_EV_TIMER (1u << 31) // TASK_SLEEP_US expired, the other event bits are free
+
+typedef struct task task_t;
+typedef int (*task_fn_t)(task_t *t);
+
+struct task {
+    task_fn_t fn;             // 0: free slot
+    void *arg;
+    uint16_t lc;              // line to resume at
+    volatile uint32_t events; // signalled but not consumed yet
+    sw_timer_t timer;
+};
+
+extern uint8_t task_progress; // set when a task got past a wait in the current round
+
+#define TASK_BEGIN(t) switch ((t)->lc) { case 0:
+#define TASK_END(t)   } (t)->lc = 0; return TASK_EXITED
+
+// return until cond holds
+#define TASK_WAIT_UNTIL(t, cond)                                                                  \
+    do {                                                                                          \
+        (t)->lc = __LINE__;                                                                       \
+    case __LINE__:                                                                                \
+        if (!(cond)) return TASK_WAITING;                                                         \
+        task_progress = 1;                                                                        \
+    } while (0)
+
+// let the other tasks run once
+#define TASK_YIELD(t)                                                                             \
+    do {                                                                                          \
+        (t)->lc = __LINE__;                                                                       \
+        return TASK_YIELDED;                                                                      \
+    case __LINE__:;                                                                               \
+    } while (0)
+
+// wait for any of the event bits in mask and consume them
+#define TASK_WAIT_EVENT(t, mask)                                                                  \
+    do {                                                                                          \
+        TASK_WAIT_UNTIL(t, (t)->events & (mask));                                                 \
+        (t)->events &= ~(mask);                                                                   \
+    } while (0)
+
+#define TASK_SLEEP_US(t, us)                                                                      \
+    do {                                                                                          \
+        task_sleep_start(t, us);                                                                  \
+        TASK_WAIT_EVENT(t, TASK_EV_TIMER);                                                        \
+    } while (0)
+
+#define TASK_EXIT(t)                                                                              \
+    do {                                                                                          \
+        (t)->lc = 0;                                                                              \
+        return TASK_EXITED;                                                                       \
+    } while (0)
+
+// take a free slot for fn, returns 0 if the table is full
+task_t *task_create(task_fn_t fn, void *arg);
+// set event bits of t, from interrupt handlers, timer callbacks or other tasks
+void task_signal(task_t *t, uint32_t events);
+// signal TASK_EV_TIMER to t after us (used by TASK_SLEEP_US)
+void task_sleep_start(task_t *t, uint32_t us);
+// run the tasks until all of them exited, returns the microseconds spent asleep in wfi
+uint32_t task_run(void);
+
+#ifdef __cplusplus
+}
+#endif
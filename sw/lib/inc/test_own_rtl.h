@@ -7,7 +7,8 @@
     void test_nop (void);
 #endif
 
-#if TEST_REG_PART_F1 || TEST_REG_PART_F2 || TEST_REG_PART_CNT || TEST_RUN_ALL_PULSERS || TEST_RUN_PULSER_ONE_BY_ONE
+#if TEST_REG_PART_F1 || TEST_REG_PART_F2 || TEST_REG_PART_CNT || TEST_RUN_ALL_PULSERS || TEST_RUN_PULSER_ONE_BY_ONE || \
+    TEST_RUN_PULSER_QUEUE || TEST_RUN_PULSER_IRQ || TEST_RUN_PULSER_TRIGGER
     #include "pulser.h"
     #ifdef __cplusplus
     extern "C"
@@ -17,13 +18,16 @@
         void test_pulser_regs(pulser_id_t id);
         void test_pulser_run_all(void);
         void test_pulser_one_by_one(void);
+        void test_pulser_queue(void);
+        void test_pulser_irq(void);
+        void test_pulser_trigger(void);
 
     #ifdef __cplusplus
     } // extern "C"
     #endif
 #endif
 
-#if TEST_RUN_ADV_TIMER || TEST_RUN_ADV_TIMER_INTERRUPT
+#if TEST_RUN_ADV_TIMER || TEST_RUN_ADV_TIMER_INTERRUPT || TEST_RUN_PULSER_TRIGGER || TEST_RUN_ADV_TIMER_CAPTURE
     #include "adv_timer.h"
     #ifdef __cplusplus
     extern "C"
@@ -31,6 +35,20 @@
     #endif
         void test_adv_timer(void);
         void test_adv_timer_interrupt(void);
+        void test_adv_timer_capture(void);
+
+    #ifdef __cplusplus
+    } // extern "C"
+    #endif
+#endif
+
+#if TEST_RUN_DMA_MODES
+    #include "dma.h"
+    #ifdef __cplusplus
+    extern "C"
+    {
+    #endif
+        void test_dma_modes(void);
 
     #ifdef __cplusplus
     } // extern "C"
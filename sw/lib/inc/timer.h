@@ -9,6 +9,10 @@
 #include <stdint.h>
 #include "config.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // Register offsets
 #define CFG_LOW_REG_OFFSET            0x00
 #define CFG_HIGH_REG_OFFSET           0x04
@@ -40,4 +44,46 @@
 #define CFG_HIGH_REG_PRESC_ENABLE_BIT 6
 #define CFG_HIGH_REG_CLOCK_SOURCE_BIT 7
 
+// Timer service
+// The low counter runs free from the system clock with a prescaler to 1 us ticks (from
+// TB_FREQUENCY, no calibration at runtime) and wraps after about 71 minutes. Software timers
+// are kept in a list sorted by deadline, the low comparator is always armed for the first one
+// and its interrupt (IRQ_TIMER) runs the callbacks. The high counter stays free for other uses.
+// Callbacks run in interrupt context (or inside timer_sleep_us) and must be short.
+// IRQ_TIMER is a one-cycle pulse that the core does not latch: a deadline that passes while
+// interrupts are disabled would be lost and the timers would stall until the counter wraps.
+// irq_unlock() therefore runs the expired timers (timer_poll_locked) before enabling
+// interrupts again, and timer_add/timer_cancel/timer_poll do the same. Interrupt handlers return
+// with mret instead, so a deadline passing during another handler is only served at the next of
+// these calls; handlers that run for longer than a few us call timer_poll() before returning.
+#define TIMER_TICKS_PER_US  (TB_FREQUENCY / 1000000)
+#define TIMER_MIN_DELTA_US  2 // closer deadlines are waited out instead of armed
+
+typedef void (*timer_callback_t)(void *arg);
+
+typedef struct sw_timer {
+    struct sw_timer *next;
+    uint32_t deadline; // timer_now_us() at expiry
+    uint32_t period;   // 0: one-shot
+    timer_callback_t callback;
+    void *arg;
+} sw_timer_t;
+
+void timer_init(void); // called by the first timer_add(), later calls do nothing
+uint32_t timer_now_us(void);
+// (re)start t: callback(arg) after delay_us, then every period_us if not 0
+void timer_add(sw_timer_t *t, uint32_t delay_us, uint32_t period_us, timer_callback_t callback,
+               void *arg);
+void timer_cancel(sw_timer_t *t);
+// run expired timers now, for code that keeps interrupts disabled for longer
+void timer_poll(void);
+// same with interrupts already disabled, called by irq_unlock()
+void timer_poll_locked(void);
+// sleep in wfi until us have passed, other timers and interrupts are served meanwhile
+void timer_sleep_us(uint32_t us);
+
 void sleep_ms(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
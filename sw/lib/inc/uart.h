@@ -10,6 +10,10 @@
 #include <stdint.h>
 #include "config.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // Registers below can be aligned to a byte, word, dword etc
 // UART_BYTE_ALIGN provides the number of bytes it is aligned to
 
@@ -29,10 +33,14 @@
 #define UART_DLAB_MSB_REG_OFFSET      (1*UART_BYTE_ALIGN)
 
 // Register fields
+#define UART_INTR_ENABLE_DATA_READY_BIT 0
+#define UART_INTR_ENABLE_THR_EMPTY_BIT  1
 #define UART_LINE_STATUS_DATA_READY_BIT 0
 #define UART_LINE_STATUS_THR_EMPTY_BIT  5
 #define UART_LINE_STATUS_TMIT_EMPTY_BIT 6
 
+#define UART_FIFO_DEPTH 16
+
 void uart_init();
 
 void uart_loopback_enable();
@@ -43,6 +51,7 @@ int uart_read_ready();
 
 void uart_write(uint8_t byte);
 
+// blocks until all bytes are in the TX FIFO (or the TX ring buffer in interrupt-driven mode)
 void uart_write_str(void *src, uint32_t len);
 
 void uart_write_flush();
@@ -54,3 +63,29 @@ void uart_read_str(void *dst, uint32_t len);
 void putchar(char byte);
 
 char getchar();
+
+// Interrupt-driven mode: TX and RX go through ring buffers in SRAM (UART_TX/RX_BUF_SIZE),
+// which uart_irq_handler() moves to/from the hardware FIFOs.
+// putchar (and thus printf) only blocks while the TX ring buffer is full. The blocking calls
+// sleep in wfi until the interrupt made progress, with interrupts disabled (in a handler or a
+// task, under irq_lock()) they poll the UART instead.
+void uart_async_enable();
+
+// copy up to len bytes into the TX ring buffer, returns the number of bytes accepted
+uint32_t uart_write_async(const void *src, uint32_t len);
+
+// free space in the TX ring buffer, uart_write_async() accepts this many bytes
+uint32_t uart_write_space();
+
+// number of received bytes waiting in the RX ring buffer
+uint32_t uart_read_avail();
+
+// copy up to len bytes out of the RX ring buffer, returns the number of bytes read
+uint32_t uart_read_async(void *dst, uint32_t len);
+
+// interrupt handler, registered for IRQ_UART by uart_async_enable()
+void uart_irq_handler();
+
+#ifdef __cplusplus
+}
+#endif
@@ -46,16 +46,21 @@ static inline void set_mie(int enable) {
         asm volatile("csrci mstatus, 8" ::: "memory");
 }
 
-// Get cycle count since reset
+// Get cycle count since reset (hi/lo/hi read, consistent across a low word overflow)
 static inline uint64_t get_mcycle() {
-    uint64_t mcycle;
-    asm volatile("csrr %0, mcycle" : "=r"(mcycle)::"memory");
-    return mcycle;
+    uint32_t hi, lo, hi2;
+    asm volatile("csrr %0, mcycleh" : "=r"(hi2)::"memory");
+    do {
+        hi = hi2;
+        asm volatile("csrr %0, mcycle" : "=r"(lo)::"memory");
+        asm volatile("csrr %0, mcycleh" : "=r"(hi2)::"memory");
+    } while (hi != hi2);
+    return ((uint64_t)hi << 32) | lo;
 }
 
 // This may also be used to invoke code that does not return.
 static inline uint64_t invoke(void *code) {
-    uint64_t (*code_fun_ptr)(void) = code;
+    uint64_t (*code_fun_ptr)(void) = (uint64_t(*)(void))code;
     fencei();
     return code_fun_ptr();
 }
@@ -80,3 +85,32 @@ static inline void *gprw(void *gp) {
     if (!(cond)) return (ret);
 
 #define MIN(a, b) (((a) <= (b)) ? (a) : (b))
+
+// Single bit helpers, compile to bset/bclr/bext with Zbs (RV32B != 0)
+static inline uint32_t bit_set(uint32_t x, int bit) {
+    return x | (1u << bit);
+}
+
+static inline uint32_t bit_clear(uint32_t x, int bit) {
+    return x & ~(1u << bit);
+}
+
+static inline uint32_t bit_get(uint32_t x, int bit) {
+    return (x >> bit) & 1u;
+}
+
+// Count leading zeros, x must not be 0 (clz with Zbb). Without Zbb __builtin_clz would pull in
+// libgcc's __clzsi2 and its 256 byte table, a binary search is smaller.
+static inline int bit_clz(uint32_t x) {
+#ifdef __riscv_zbb
+    return __builtin_clz(x);
+#else
+    int n = 0;
+    if (!(x & 0xFFFF0000u)) { n += 16; x <<= 16; }
+    if (!(x & 0xFF000000u)) { n += 8; x <<= 8; }
+    if (!(x & 0xF0000000u)) { n += 4; x <<= 4; }
+    if (!(x & 0xC0000000u)) { n += 2; x <<= 2; }
+    if (!(x & 0x80000000u)) { n += 1; }
+    return n;
+#endif
+}
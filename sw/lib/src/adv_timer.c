@@ -1,102 +1,289 @@
-
 #include "util.h"
 #include "config.h"
 #include "adv_timer.h"
+#include "irq.h"
 
-void timer0_init(int topvalue)
+// SRAM copy of the writable registers, see adv_timer.h
+typedef struct
 {
-    // Reset the timer before configuring
-    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_CMD) = TIM_CMD_RST;
+    uint32_t cfg;
+    uint32_t th;
+    uint32_t ch_th[ADV_TIMER_N_CHANNELS];
+    uint32_t ch_lut[ADV_TIMER_N_CHANNELS];
+} adv_timer_shadow_t;
 
-    // Select Clock: set TIM_CFG_SEL_CLK_SRC and mode = 0 to use low speed clock
-    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_CFG) |= TIM_CFG_SEL_CLK_SRC;
+static adv_timer_shadow_t adv_timer_shadow[ADV_TIMER_N_TIMERS];
+static uint32_t adv_timer_event_cfg;
+static uint32_t adv_timer_ch_en;
+static uint16_t adv_timer_staged; // bit 4*timer+ch: CHx_TH differs from the timer
 
-    // Enable Clock of timer 0
-    *reg32(ADV_TIMER_BASE_ADDR, REG_CH_EN) |= REG_TIM0_EN;
+void adv_timer_sync(void)
+{
+    for (int t = 0; t < ADV_TIMER_N_TIMERS; t++)
+    {
+        adv_timer_shadow_t *sh = &adv_timer_shadow[t];
+        sh->cfg = *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CFG(t));
+        sh->th = *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_TH(t));
+        for (int ch = 0; ch < ADV_TIMER_N_CHANNELS; ch++)
+        {
+            sh->ch_th[ch] = *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CH_TH(t, ch));
+            sh->ch_lut[ch] = *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CH_LUT(t, ch));
+        }
+    }
+    adv_timer_event_cfg = *reg32(ADV_TIMER_BASE_ADDR, REG_EVENT_CFG);
+    adv_timer_ch_en = *reg32(ADV_TIMER_BASE_ADDR, REG_CH_EN);
+    adv_timer_staged = 0;
+}
 
-    // Set the bottom and top value of the counter
-    // From where to where should be counted (both values are included).
-    timer0_set_bottom_top_value(0, topvalue);
+// Configuration
+void adv_timer_config(int timer_id, uint32_t cfg)
+{
+    adv_timer_shadow[timer_id].cfg = cfg;
+    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CFG(timer_id)) = cfg;
+}
 
-    // Set r_timer0_ch0_mode to OP_RSTSET and set the threshold to 0
-    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_CH0_TH) = (0b110 << 16) | 0;
+void adv_timer_set_range(int timer_id, int bottomvalue, int topvalue)
+{
+    uint32_t th = ((uint32_t)(topvalue & 0xFFFF) << 16) | (bottomvalue & 0xFFFF);
+    adv_timer_shadow[timer_id].th = th;
+    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_TH(timer_id)) = th;
 }
 
-void adv_timer_enable_event(int timer_id, int sel_channel)
+void adv_timer_set_channel(int timer_id, int ch, int mode, int threshold)
+{
+    adv_timer_shadow[timer_id].ch_th[ch] = TIM_CH_TH(mode, threshold);
+    adv_timer_staged |= 1 << (4 * timer_id + ch);
+}
+
+void adv_timer_set_threshold(int timer_id, int ch, int threshold)
+{
+    uint32_t ch_th = adv_timer_shadow[timer_id].ch_th[ch];
+    adv_timer_shadow[timer_id].ch_th[ch] = (ch_th & ~0xFFFFu) | (threshold & 0xFFFF);
+    adv_timer_staged |= 1 << (4 * timer_id + ch);
+}
+
+void adv_timer_set_lut(int timer_id, int ch, uint32_t lut)
+{
+    adv_timer_shadow[timer_id].ch_lut[ch] = lut;
+    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CH_LUT(timer_id, ch)) = lut;
+}
+
+void adv_timer_commit(int timers_to_update)
+{
+    // all register writes first, then the update commands back to back
+    for (int t = 0; t < ADV_TIMER_N_TIMERS; t++)
+    {
+        uint32_t staged = (adv_timer_staged >> (4 * t)) & 0xF;
+        if (!(timers_to_update & (1 << t)) || !staged)
+            continue;
+        for (int ch = 0; ch < ADV_TIMER_N_CHANNELS; ch++)
+        {
+            if (staged & (1 << ch))
+                *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CH_TH(t, ch)) = adv_timer_shadow[t].ch_th[ch];
+        }
+        adv_timer_staged &= ~(0xF << (4 * t));
+    }
+    for (int t = 0; t < ADV_TIMER_N_TIMERS; t++)
+    {
+        if (timers_to_update & (1 << t))
+            *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CMD(t)) = TIM_CMD_UPDATE;
+    }
+}
+
+// Control, the command register only takes writes
+void adv_timer_clk_enable(int timers_to_en)
+{
+    adv_timer_ch_en |= timers_to_en;
+    *reg32(ADV_TIMER_BASE_ADDR, REG_CH_EN) = adv_timer_ch_en;
+}
+
+void adv_timer_clk_disable(int timers_to_dis)
+{
+    adv_timer_ch_en &= ~timers_to_dis;
+    *reg32(ADV_TIMER_BASE_ADDR, REG_CH_EN) = adv_timer_ch_en;
+}
+
+void adv_timer_start(int timer_id)
 {
     // Check if timer_id is valid (0-3)
     if (timer_id < 0 || timer_id > 3) {
         return; // Invalid timer ID
     }
-    if (sel_channel < 0 || sel_channel > 3) {
-        return; // Invalid channel selection
-    }
+    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CMD(timer_id)) = TIM_CMD_START;
+}
 
-    // Select the channel for event generation
-    *reg32(ADV_TIMER_BASE_ADDR, REG_EVENT_CFG) |= ((sel_channel) << 4 * timer_id);
-    // Enable event generation for the specified timer
-    *reg32(ADV_TIMER_BASE_ADDR, REG_EVENT_CFG) |= ((1 << timer_id) << 16);
+void adv_timer_stop(int timer_id)
+{
+    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CMD(timer_id)) = TIM_CMD_STOP;
 }
-void adv_timer_start(int timer_id)
+
+void adv_timer_reset(int timer_id)
+{
+    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_CMD(timer_id)) = TIM_CMD_RST;
+}
+
+void adv_timer_enable_event(int timer_id, int sel_channel)
 {
     // Check if timer_id is valid (0-3)
     if (timer_id < 0 || timer_id > 3) {
         return; // Invalid timer ID
     }
+    if (sel_channel < 0 || sel_channel > 3) {
+        return; // Invalid channel selection
+    }
 
-    // Start the specified timer
-    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_CMD + (timer_id * 0x40)) |= TIM_CMD_START;
+    // Select the channel for event generation and enable it
+    adv_timer_event_cfg &= ~(0xFu << 4 * timer_id);
+    adv_timer_event_cfg |= (sel_channel << 4 * timer_id) | ((1 << timer_id) << 16);
+    *reg32(ADV_TIMER_BASE_ADDR, REG_EVENT_CFG) = adv_timer_event_cfg;
 }
 
-void timer0_pwm_init(int nCycles, int dutyCycle)
+void adv_timer_disable_event(int timer_id)
 {
-    // Reset the timer before configuring
-    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_CMD) = TIM_CMD_RST;
+    adv_timer_event_cfg &= ~((1 << timer_id) << 16);
+    *reg32(ADV_TIMER_BASE_ADDR, REG_EVENT_CFG) = adv_timer_event_cfg;
+}
 
-    // Select Clock: set TIM_CFG_SEL_CLK_SRC and mode = 0 to use low speed clock (RTC)
-    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_CFG) &= ~TIM_CFG_SEL_CLK_SRC;
+// Reading, only the counter goes to the timer
+int adv_timer_get_counter(int timer_id)
+{
+    return *reg32(ADV_TIMER_BASE_ADDR, REG_TIM_COUNTER(timer_id));
+}
 
-    // Enable Clock of timer 0
-    *reg32(ADV_TIMER_BASE_ADDR, REG_CH_EN) |= REG_TIM0_EN;
+int adv_timer_get_top_value(int timer_id)
+{
+    return adv_timer_shadow[timer_id].th >> 16;
+}
+
+int adv_timer_get_bottom_value(int timer_id)
+{
+    return adv_timer_shadow[timer_id].th & 0xFFFF;
+}
 
-    // assert(dutyCycle >= 0 && dutyCycle <= 100);
-    int toggle_val;
+int adv_timer_get_threshold(int timer_id, int ch)
+{
+    return adv_timer_shadow[timer_id].ch_th[ch] & 0xFFFF;
+}
+
+void adv_timer_pwm_init(int timer_id, int ch, int nCycles, int dutyCycle)
+{
+    // Reset the timer before configuring
+    adv_timer_reset(timer_id);
+
+    // Select Clock: clear TIM_CFG_SEL_CLK_SRC and mode = 0 to use low speed clock (RTC)
+    adv_timer_config(timer_id, adv_timer_shadow[timer_id].cfg & ~TIM_CFG_SEL_CLK_SRC);
+    adv_timer_clk_enable(1 << timer_id);
+
+    int toggle_val = nCycles / 2;
     if (dutyCycle >= 0 && dutyCycle <= 100)
     {
         toggle_val = (nCycles * dutyCycle) / 100;
     }
-    else
-    {
-        int toggle_val = nCycles / 2;
-    }
-    // Set r_timer0_ch0_mode to OP_SETRST and set the threshold
-    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_CH0_TH) = (0b010 << 16) | toggle_val;
+    // Set the channel mode to OP_SETRST and the threshold
+    adv_timer_set_channel(timer_id, ch, TIM_CH_MODE_SETRST, toggle_val);
+
+    // Set the bottom and top value of the counter
+    // From where to where should be counted (both values are included).
+    adv_timer_set_range(timer_id, 1, nCycles);
+    adv_timer_commit(1 << timer_id);
+
+    adv_timer_start(timer_id);
+}
+
+// Input capture
+void adv_timer_capture_init(int pin, int rising, int falling, int threshold,
+                            adv_timer_capture_handler_t handler)
+{
+    if (!handler)
+        threshold = 0;
+    *reg32(ADV_TIMER_BASE_ADDR, REG_CAP_CFG) = 0; // no edges while flushing
+    *reg32(ADV_TIMER_BASE_ADDR, REG_CAP_FLUSH) = 1;
+    *reg32(ADV_TIMER_BASE_ADDR, REG_CAP_STATUS) = CAP_STATUS_OVERFLOW;
+    irq_register(IRQ_ADV_TIMER_CAPTURE, threshold ? handler : 0);
+    *reg32(ADV_TIMER_BASE_ADDR, REG_CAP_CFG) = (pin & 0x1F) | (rising ? CAP_CFG_RISING : 0) |
+                                               (falling ? CAP_CFG_FALLING : 0) |
+                                               ((threshold & 0xFF) << 8);
+}
+
+void adv_timer_capture_disable(void)
+{
+    *reg32(ADV_TIMER_BASE_ADDR, REG_CAP_CFG) = 0;
+    irq_register(IRQ_ADV_TIMER_CAPTURE, 0);
+}
+
+int adv_timer_capture_level(void)
+{
+    return *reg32(ADV_TIMER_BASE_ADDR, REG_CAP_STATUS) & 0xFF;
+}
+
+int adv_timer_capture_overflow(void)
+{
+    uint32_t status = *reg32(ADV_TIMER_BASE_ADDR, REG_CAP_STATUS);
+    if (!(status & CAP_STATUS_OVERFLOW))
+        return 0;
+    *reg32(ADV_TIMER_BASE_ADDR, REG_CAP_STATUS) = CAP_STATUS_OVERFLOW;
+    return 1;
+}
+
+int adv_timer_capture_read(uint32_t *entries, int max)
+{
+    // one status read, then back-to-back pops
+    int n = adv_timer_capture_level();
+    if (n > max)
+        n = max;
+    volatile uint32_t *data = reg32(ADV_TIMER_BASE_ADDR, REG_CAP_DATA);
+    for (int i = 0; i < n; i++)
+        entries[i] = *data;
+    return n;
+}
+
+uint32_t adv_timer_capture_time(void)
+{
+    return *reg32(ADV_TIMER_BASE_ADDR, REG_CAP_TIME);
+}
+
+// Timer 0
+void timer0_init(int topvalue)
+{
+    // Reset the timer before configuring
+    adv_timer_reset(0);
+
+    // Select Clock: set TIM_CFG_SEL_CLK_SRC and mode = 0 to use low speed clock
+    adv_timer_config(0, adv_timer_shadow[0].cfg | TIM_CFG_SEL_CLK_SRC);
+
+    // Enable Clock of timer 0
+    adv_timer_clk_enable(1 << 0);
 
     // Set the bottom and top value of the counter
     // From where to where should be counted (both values are included).
-    timer0_set_bottom_top_value(1, nCycles);
+    adv_timer_set_range(0, 0, topvalue);
+
+    // Set the channel 0 mode to OP_RSTSET and the threshold to 0
+    adv_timer_set_channel(0, 0, TIM_CH_MODE_RSTSET, 0);
+    adv_timer_commit(1 << 0);
+}
 
-    // Start timer 0
-    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_CMD) |= TIM_CMD_START;
+void timer0_pwm_init(int nCycles, int dutyCycle)
+{
+    adv_timer_pwm_init(0, 0, nCycles, dutyCycle);
 }
 
 int timer0_get_counter()
 {
-    return *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_COUNTER);
+    return adv_timer_get_counter(0);
 }
 
 int timer0_get_top_value()
 {
-    return (*reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_TH) >> 16);
+    return adv_timer_get_top_value(0);
 }
 
 int timer0_get_bottom_value()
 {
-    return *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_TH) & 0xFFFF;
+    return adv_timer_get_bottom_value(0);
 }
 
 void timer0_set_bottom_top_value(int bottomvalue, int topvalue)
 {
-    int regvalue = ((topvalue & 0xFFFF) << 16) | (bottomvalue & 0xFFFF);
-    *reg32(ADV_TIMER_BASE_ADDR, REG_TIM0_TH) = regvalue;
-}
\ No newline at end of file
+    adv_timer_set_range(0, bottomvalue, topvalue);
+}
@@ -0,0 +1,23 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Minimal C++ runtime support, only linked if C++ code refers to it.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+// main() never returns to a system that would run them, so static destructors are not registered
+void *__dso_handle;
+
+int __cxa_atexit(void (*destructor)(void *), void *arg, void *dso) {
+    (void)destructor;
+    (void)arg;
+    (void)dso;
+    return 0;
+}
+
+// Called for a pure virtual function, only possible from a constructor or destructor
+void __cxa_pure_virtual(void) {
+    while (1)
+        ;
+}
@@ -0,0 +1,54 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "dma.h"
+#include "irq.h"
+#include "util.h"
+#include "config.h"
+
+static dma_callback_t dma_callback;
+static uint32_t dma_irq_en; // IRQ_EN bit for the CTRL register
+
+void dma_start(volatile void *dst, const volatile void *src, uint32_t len, uint32_t mode,
+               uint32_t size) {
+    *reg32(DMA_BASE_ADDR, DMA_SRC_REG_OFFSET) = (uint32_t)src;
+    *reg32(DMA_BASE_ADDR, DMA_DST_REG_OFFSET) = (uint32_t)dst;
+    *reg32(DMA_BASE_ADDR, DMA_LEN_REG_OFFSET) = len;
+    *reg32(DMA_BASE_ADDR, DMA_CTRL_REG_OFFSET) = mode | size | dma_irq_en |
+                                                 (1 << DMA_CTRL_START_BIT);
+}
+
+int dma_busy(void) {
+    return *reg32(DMA_BASE_ADDR, DMA_STATUS_REG_OFFSET) & (1 << DMA_STATUS_BUSY_BIT);
+}
+
+int dma_wait(void) {
+    uint32_t status;
+    do {
+        status = *reg32(DMA_BASE_ADDR, DMA_STATUS_REG_OFFSET);
+    } while (status & (1 << DMA_STATUS_BUSY_BIT));
+    return (status & (1 << DMA_STATUS_ERROR_BIT)) ? -1 : 0;
+}
+
+void dma_memcpy(void *dst, const void *src, uint32_t len) {
+    uint32_t size = (((uint32_t)dst | (uint32_t)src | len) & 3) ? DMA_SIZE_BYTE : DMA_SIZE_WORD;
+    dma_start(dst, src, len, DMA_MEM_TO_MEM, size);
+    dma_wait();
+}
+
+static void dma_irq_handler(void) {
+    uint32_t status = *reg32(DMA_BASE_ADDR, DMA_STATUS_REG_OFFSET);
+    // clear DONE/ERROR, this also lowers the interrupt
+    *reg32(DMA_BASE_ADDR, DMA_STATUS_REG_OFFSET) = status;
+    if (dma_callback)
+        dma_callback(status);
+}
+
+void dma_set_callback(dma_callback_t callback) {
+    dma_callback = callback;
+    dma_irq_en   = callback ? (1 << DMA_CTRL_IRQ_EN_BIT) : 0;
+    irq_register(IRQ_DMA, callback ? dma_irq_handler : 0);
+}
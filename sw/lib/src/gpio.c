@@ -8,6 +8,18 @@
 #include "gpio.h"
 #include "util.h"
 #include "config.h"
+#include "irq.h"
+
+// Read-modify-write of a single register bit (bset/bclr with Zbs)
+static inline void gpio_reg_set_bit(int offs, uint8_t bit) {
+    volatile uint32_t *reg = reg32(GPIO_BASE_ADDR, offs);
+    *reg = bit_set(*reg, bit);
+}
+
+static inline void gpio_reg_clear_bit(int offs, uint8_t bit) {
+    volatile uint32_t *reg = reg32(GPIO_BASE_ADDR, offs);
+    *reg = bit_clear(*reg, bit);
+}
 
 void gpio_set_direction(uint32_t mask, uint32_t direction) {
     uint32_t dir_old = *reg32(GPIO_BASE_ADDR, GPIO_DIR_REG_OFFSET);
@@ -53,23 +65,23 @@ uint32_t gpio_get_interrupt_status(void) {
 }
 
 void gpio_pin_set_output(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_DIR_REG_OFFSET) |= (1 << gpio_pin);
+    gpio_reg_set_bit(GPIO_DIR_REG_OFFSET, gpio_pin);
 }
 
 void gpio_pin_enable(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_EN_REG_OFFSET) |= (1 << gpio_pin);
+    gpio_reg_set_bit(GPIO_EN_REG_OFFSET, gpio_pin);
 }
 
 void gpio_pin_disable(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_EN_REG_OFFSET) &= ~(1 << gpio_pin);
+    gpio_reg_clear_bit(GPIO_EN_REG_OFFSET, gpio_pin);
 }
 
 void gpio_pin_set(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_OUT_REG_OFFSET) |= (1 << gpio_pin);
+    gpio_reg_set_bit(GPIO_OUT_REG_OFFSET, gpio_pin);
 }
 
 void gpio_pin_clear(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_OUT_REG_OFFSET) &= ~(1 << gpio_pin);
+    gpio_reg_clear_bit(GPIO_OUT_REG_OFFSET, gpio_pin);
 }
 
 void gpio_pin_toggle(uint8_t gpio_pin) {
@@ -77,23 +89,96 @@ void gpio_pin_toggle(uint8_t gpio_pin) {
 }
 
 uint8_t gpio_pin_read(uint8_t gpio_pin) {
-    return (*reg32(GPIO_BASE_ADDR, GPIO_IN_REG_OFFSET) >> gpio_pin) & 1;
+    return bit_get(*reg32(GPIO_BASE_ADDR, GPIO_IN_REG_OFFSET), gpio_pin);
 }
 
 void gpio_pin_enable_rising_interrupt(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EDGE_REG_OFFSET) |= (1 << gpio_pin);
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET) |= (1 << gpio_pin);
+    gpio_reg_set_bit(GPIO_INTRPT_EDGE_REG_OFFSET, gpio_pin);
+    gpio_reg_set_bit(GPIO_INTRPT_EN_REG_OFFSET, gpio_pin);
 }
 
 void gpio_pin_enable_falling_interrupt(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EDGE_REG_OFFSET) &= ~(1 << gpio_pin);
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET) |= (1 << gpio_pin);
+    gpio_reg_clear_bit(GPIO_INTRPT_EDGE_REG_OFFSET, gpio_pin);
+    gpio_reg_set_bit(GPIO_INTRPT_EN_REG_OFFSET, gpio_pin);
 }
 
 void gpio_pin_disable_interrupts(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET) &= ~(1 << gpio_pin);
+    gpio_reg_clear_bit(GPIO_INTRPT_EN_REG_OFFSET, gpio_pin);
 }
 
 uint8_t gpio_pin_get_interrupt_status(uint8_t gpio_pin) {
-    return (*reg32(GPIO_BASE_ADDR, GPIO_INTRPT_STATUS_REG_OFFSET) >> gpio_pin) & 1;
+    return bit_get(*reg32(GPIO_BASE_ADDR, GPIO_INTRPT_STATUS_REG_OFFSET), gpio_pin);
+}
+
+// Pattern stream
+#define GPIO_STREAM_WATERMARK (GPIO_STREAM_DEPTH / 2)
+
+static const uint32_t *gpio_stream_src; // rest of the table for gpio_stream_play()
+static volatile uint32_t gpio_stream_left;
+
+void gpio_stream_init(uint32_t mask, uint32_t period) {
+    *reg32(GPIO_BASE_ADDR, GPIO_STREAM_CTRL_REG_OFFSET) = 0;
+    *reg32(GPIO_BASE_ADDR, GPIO_STREAM_DIV_REG_OFFSET) = period ? period - 1 : 0;
+    *reg32(GPIO_BASE_ADDR, GPIO_STREAM_MASK_REG_OFFSET) = mask;
+    *reg32(GPIO_BASE_ADDR, GPIO_STREAM_STATUS_REG_OFFSET) =
+        GPIO_STREAM_STATUS_UNDERRUN | GPIO_STREAM_STATUS_OVERFLOW;
+}
+
+void gpio_stream_start(void) {
+    uint32_t irq_en = gpio_stream_left ? GPIO_STREAM_CTRL_IRQ_EN : 0;
+    *reg32(GPIO_BASE_ADDR, GPIO_STREAM_CTRL_REG_OFFSET) =
+        (GPIO_STREAM_WATERMARK << 8) | irq_en | GPIO_STREAM_CTRL_PLAY;
+}
+
+void gpio_stream_stop(void) {
+    *reg32(GPIO_BASE_ADDR, GPIO_STREAM_CTRL_REG_OFFSET) = 0;
+    gpio_stream_left = 0;
+}
+
+// write as many words as fit, one status read per burst
+static uint32_t gpio_stream_fill(const uint32_t *words, uint32_t count) {
+    uint32_t level = *reg32(GPIO_BASE_ADDR, GPIO_STREAM_STATUS_REG_OFFSET) & 0xFF;
+    uint32_t n = GPIO_STREAM_DEPTH - level;
+    if (n > count)
+        n = count;
+    volatile uint32_t *data = reg32(GPIO_BASE_ADDR, GPIO_STREAM_DATA_REG_OFFSET);
+    for (uint32_t i = 0; i < n; i++)
+        *data = words[i];
+    return n;
+}
+
+void gpio_stream_write(const uint32_t *words, uint32_t count) {
+    while (count) {
+        uint32_t n = gpio_stream_fill(words, count);
+        words += n;
+        count -= n;
+    }
+}
+
+static void gpio_stream_irq_handler(void) {
+    uint32_t n = gpio_stream_fill(gpio_stream_src, gpio_stream_left);
+    gpio_stream_src += n;
+    gpio_stream_left -= n;
+    if (!gpio_stream_left) // table queued, let the FIFO drain
+        *reg32(GPIO_BASE_ADDR, GPIO_STREAM_CTRL_REG_OFFSET) &= ~GPIO_STREAM_CTRL_IRQ_EN;
+}
+
+void gpio_stream_play(const uint32_t *words, uint32_t count) {
+    uint32_t n = gpio_stream_fill(words, count);
+    gpio_stream_src = words + n;
+    gpio_stream_left = count - n;
+    irq_register(IRQ_GPIO_STREAM, gpio_stream_irq_handler);
+    gpio_stream_start();
+}
+
+int gpio_stream_busy(void) {
+    return gpio_stream_left != 0;
+}
+
+int gpio_stream_underrun(void) {
+    uint32_t status = *reg32(GPIO_BASE_ADDR, GPIO_STREAM_STATUS_REG_OFFSET);
+    if (!(status & GPIO_STREAM_STATUS_UNDERRUN))
+        return 0;
+    *reg32(GPIO_BASE_ADDR, GPIO_STREAM_STATUS_REG_OFFSET) = GPIO_STREAM_STATUS_UNDERRUN;
+    return 1;
 }
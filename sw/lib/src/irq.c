@@ -0,0 +1,46 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "irq.h"
+#include "util.h"
+
+// Provided by crt0.S: vector table (at the boot address) and the C dispatcher
+extern uint32_t _start[IRQ_NUM];
+extern void _trap_irq(void);
+
+// Looked up by _trap_irq, unset entries get masked in mie on their first trap
+irq_handler_t irq_handlers[IRQ_NUM];
+
+// Overwrite a vector table entry with `jal x0, target`
+static void irq_set_jump(int irq, void *target) {
+    uint32_t offs = (uint32_t)target - (uint32_t)&_start[irq];
+    _start[irq] = ((offs & 0x100000) << 11) |  // imm[20]
+                  ((offs & 0x7FE) << 20) |     // imm[10:1]
+                  ((offs & 0x800) << 9) |      // imm[11]
+                  (offs & 0xFF000) |           // imm[19:12]
+                  0x6F;                        // jal x0
+    fencei();
+}
+
+static void irq_enable(int irq, int enable) {
+    if (enable)
+        asm volatile("csrs mie, %0" ::"r"(1 << irq) : "memory");
+    else
+        asm volatile("csrc mie, %0" ::"r"(1 << irq) : "memory");
+}
+
+void irq_register(int irq, irq_handler_t handler) {
+    irq_enable(irq, 0);
+    irq_handlers[irq] = handler;
+    irq_set_jump(irq, _trap_irq);
+    if (handler) irq_enable(irq, 1);
+}
+
+void irq_set_vector(int irq, void (*isr)(void)) {
+    irq_enable(irq, 0);
+    irq_set_jump(irq, isr ? (void *)isr : (void *)_trap_irq);
+    if (isr) irq_enable(irq, 1);
+}
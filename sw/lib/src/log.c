@@ -0,0 +1,70 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "log.h"
+#include "uart.h"
+#include "irq.h"
+#include "config.h"
+
+#if LOG_RING_SIZE
+#define LOG_RING_MASK (LOG_RING_SIZE - 1)
+
+// Free-running indices as in the UART ring buffers. Records are added whole with interrupts
+// disabled, only log_flush() moves the tail.
+static uint8_t log_ring[LOG_RING_SIZE];
+static volatile uint16_t log_head, log_tail;
+static uint32_t log_dropped;
+#endif
+
+void log_record(uint32_t id, const uint32_t *args, uint32_t nargs) {
+    uint8_t record[3 + 4 * LOG_MAX_ARGS];
+    uint32_t len = 0;
+
+    record[len++] = LOG_RECORD_FLAG | nargs;
+    record[len++] = id;
+    record[len++] = id >> 8;
+    for (uint32_t i = 0; i < nargs; i++) {
+        uint32_t arg = args[i];
+        for (int b = 0; b < 4; b++) {
+            record[len++] = arg;
+            arg >>= 8;
+        }
+    }
+
+#if LOG_RING_SIZE
+    uint32_t mie = irq_lock();
+    if ((uint32_t)LOG_RING_SIZE - (uint32_t)(uint16_t)(log_head - log_tail) < len) {
+        log_dropped++;
+    } else {
+        for (uint32_t i = 0; i < len; i++)
+            log_ring[(log_head++) & LOG_RING_MASK] = record[i];
+    }
+    irq_unlock(mie);
+#else
+    uart_write_str(record, len);
+#endif
+}
+
+uint32_t log_flush(void) {
+#if LOG_RING_SIZE
+    while (log_tail != log_head) {
+        // up to the end of the ring in one go
+        uint32_t start = log_tail & LOG_RING_MASK;
+        uint32_t len = (uint16_t)(log_head - log_tail);
+        if (len > LOG_RING_SIZE - start)
+            len = LOG_RING_SIZE - start;
+        uart_write_str(&log_ring[start], len);
+        log_tail += len;
+    }
+    uint32_t mie = irq_lock();
+    uint32_t dropped = log_dropped;
+    log_dropped = 0;
+    irq_unlock(mie);
+    return dropped;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,86 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "perf.h"
+#include "print.h"
+#include "util.h"
+
+void perf_enable(uint32_t mask) {
+    asm volatile("csrc mcountinhibit, %0" ::"r"(mask) : "memory");
+}
+
+void perf_disable(uint32_t mask) {
+    asm volatile("csrs mcountinhibit, %0" ::"r"(mask) : "memory");
+}
+
+uint32_t perf_get_event(int counter) {
+    switch (counter) {
+        case 3:  return PERF_CSR_READ(PERF_CSR_MHPMEVENT(3));
+        case 4:  return PERF_CSR_READ(PERF_CSR_MHPMEVENT(4));
+        case 5:  return PERF_CSR_READ(PERF_CSR_MHPMEVENT(5));
+        case 6:  return PERF_CSR_READ(PERF_CSR_MHPMEVENT(6));
+        case 7:  return PERF_CSR_READ(PERF_CSR_MHPMEVENT(7));
+        case 8:  return PERF_CSR_READ(PERF_CSR_MHPMEVENT(8));
+        case 9:  return PERF_CSR_READ(PERF_CSR_MHPMEVENT(9));
+        case 10: return PERF_CSR_READ(PERF_CSR_MHPMEVENT(10));
+        case 11: return PERF_CSR_READ(PERF_CSR_MHPMEVENT(11));
+        case 12: return PERF_CSR_READ(PERF_CSR_MHPMEVENT(12));
+        default: return 0;
+    }
+}
+
+// CSR numbers are immediates, so every counter needs its own read
+void perf_snapshot(perf_t *p) {
+    p->cycles   = PERF_READ(PERF_CYCLES);
+    p->instret  = PERF_READ(PERF_INSTRET);
+    p->event[0] = PERF_READ(3);
+    p->event[1] = PERF_READ(4);
+    p->event[2] = PERF_READ(5);
+    p->event[3] = PERF_READ(6);
+    p->event[4] = PERF_READ(7);
+    p->event[5] = PERF_READ(8);
+    p->event[6] = PERF_READ(9);
+    p->event[7] = PERF_READ(10);
+    p->event[8] = PERF_READ(11);
+    p->event[9] = PERF_READ(12);
+}
+
+void perf_delta(perf_t *p) {
+    perf_t now;
+    perf_snapshot(&now);
+    p->cycles  = now.cycles - p->cycles;
+    p->instret = now.instret - p->instret;
+    for (int i = 0; i < PERF_EVENT_NUM; i++)
+        p->event[i] = now.event[i] - p->event[i];
+}
+
+#define PERF_EVENT(p, id) ((uint32_t)(p)->event[(id) - PERF_EVENT_FIRST])
+
+// All values are printed in hex (32-bit), CPI is scaled by 100
+void perf_report(const char *name, const perf_t *p) {
+    uint32_t cycles  = (uint32_t)p->cycles;
+    uint32_t instret = (uint32_t)p->instret;
+    uint32_t cpi100  = 0;
+
+    // halve both counts until cycles * 100 fits in 32 bits, the ratio stays the same
+    uint32_t c = cycles, n = instret;
+    while (c > 0xFFFFFFFFu / 100) {
+        c >>= 1;
+        n >>= 1;
+    }
+    if (n)
+        cpi100 = (c * 100) / n;
+
+    printf("[PERF] ");
+    while (*name)
+        putchar(*name++);
+    printf(": cycles 0x%x instr 0x%x CPI*100 0x%x\n", cycles, instret, cpi100);
+    printf("[PERF]   lsu stall 0x%x if stall 0x%x loads 0x%x stores 0x%x\n",
+           PERF_EVENT(p, PERF_EVENT_LSU_WAIT), PERF_EVENT(p, PERF_EVENT_IF_WAIT),
+           PERF_EVENT(p, PERF_EVENT_LOAD), PERF_EVENT(p, PERF_EVENT_STORE));
+    printf("[PERF]   jumps 0x%x branches 0x%x taken 0x%x\n", PERF_EVENT(p, PERF_EVENT_JUMP),
+           PERF_EVENT(p, PERF_EVENT_BRANCH), PERF_EVENT(p, PERF_EVENT_TAKEN));
+}
@@ -5,49 +5,159 @@
 // Philippe Sauter <phsauter@iis.ee.ethz.ch>
 
 #include "print.h"
+#include "uart.h"
 #include "util.h"
 #include "config.h"
 
 const char hex_symbols[16] = {'0', '1', '2', '3', '4', '5', '6', '7', 
                               '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
 
-/// @brief format number as hexadecimal digits
+/// @brief format number as hexadecimal digits, most significant first
 /// @return number of characters written to buffer
 uint8_t format_hex32(char *buffer, uint32_t num) {
-    uint8_t idx = 0;
-    if (num == 0) {
-        buffer[0] = hex_symbols[0];
-        return 1;
-    }
+    // number of digits from the leading zeros (clz with Zbb)
+    uint8_t len = num ? (35 - bit_clz(num)) >> 2 : 1;
 
-    while (num > 0) {
-        buffer[idx++] = hex_symbols[num & 0xF];
+    for (int idx = len - 1; idx >= 0; idx--) {
+        buffer[idx] = hex_symbols[num & 0xF];
         num >>= 4;
     }
-    return idx;
+    return len;
 }
 
-void printf(char *fmt, ...) {
-    va_list args;
-    va_start(args, fmt);
-    char buffer[12];  // holds string while assembling
-    uint8_t idx;
+// Subtracting powers of ten instead of dividing by ten: at most 9 subtractions per digit,
+// while every / and % would be a libgcc loop on RV32I.
+static const uint32_t dec_powers[9] = {1000000000, 100000000, 10000000, 1000000, 100000,
+                                       10000, 1000, 100, 10};
+
+/// @brief format number as decimal digits, most significant first
+/// @return number of characters written to buffer
+uint8_t format_dec32(char *buffer, uint32_t num) {
+    uint8_t len = 0;
+    for (int i = 0; i < 9; i++) {
+        char digit = '0';
+        while (num >= dec_powers[i]) {
+            num -= dec_powers[i];
+            digit++;
+        }
+        if (len || digit != '0')
+            buffer[len++] = digit;
+    }
+    buffer[len++] = '0' + num;
+    return len;
+}
 
+typedef struct {
+    char *buf;
+    uint32_t len;
+    uint32_t size;
+    uint8_t flush; // write out to the UART when full, otherwise drop the rest
+} print_out_t;
+
+static void print_char(print_out_t *out, char c) {
+    if (out->len == out->size) {
+        if (!out->flush)
+            return;
+        uart_write_str(out->buf, out->len);
+        out->len = 0;
+    }
+    out->buf[out->len++] = c;
+}
+
+static void print_format(print_out_t *out, const char *fmt, va_list args) {
+    char digits[10]; // longest conversion: 4294967295
     while (*fmt) {
-        if (*fmt == '%') {
+        if (*fmt != '%') {
+            print_char(out, *fmt++);
+            continue;
+        }
+        fmt++;
+
+        char pad = ' ';
+        if (*fmt == '0') {
+            pad = '0';
             fmt++;
-            if (*fmt == 'x') { // hex
-                idx = format_hex32(buffer, va_arg(args, unsigned int));
-                // print from buffer
-                for (int j = idx - 1; j >= 0; j--) {
-                    putchar(buffer[j]);
+        }
+        int width = 0;
+        while (*fmt >= '0' && *fmt <= '9')
+            width = (width << 3) + (width << 1) + (*fmt++ - '0'); // width * 10
+
+        const char *str = digits;
+        uint32_t len;
+        char sign = 0;
+        switch (*fmt) {
+            case 'x':
+                len = format_hex32(digits, va_arg(args, uint32_t));
+                break;
+            case 'u':
+                len = format_dec32(digits, va_arg(args, uint32_t));
+                break;
+            case 'd': {
+                int32_t val = va_arg(args, int32_t);
+                uint32_t num = val;
+                if (val < 0) {
+                    sign = '-';
+                    num = -num;
                 }
+                len = format_dec32(digits, num);
+                break;
             }
-        } else {
-            putchar(*fmt);
+            case 'c':
+                digits[0] = (char)va_arg(args, int);
+                len = 1;
+                break;
+            case 's':
+                str = va_arg(args, const char *);
+                for (len = 0; str[len]; len++)
+                    ;
+                break;
+            case '%':
+                digits[0] = '%';
+                len = 1;
+                break;
+            case '\0':
+                return;
+            default: // unknown conversion, skipped
+                fmt++;
+                continue;
         }
         fmt++;
+
+        width -= (int)len + (sign != 0);
+        if (sign && pad == '0')
+            print_char(out, sign); // -0042, but   -42
+        while (width-- > 0)
+            print_char(out, pad);
+        if (sign && pad == ' ')
+            print_char(out, sign);
+        while (len--)
+            print_char(out, *str++);
     }
+}
 
+void printf(const char *fmt, ...) {
+    char buffer[PRINT_BUF_SIZE];
+    print_out_t out = {buffer, 0, PRINT_BUF_SIZE, 1};
+
+    va_list args;
+    va_start(args, fmt);
+    print_format(&out, fmt, args);
     va_end(args);
+
+    if (out.len)
+        uart_write_str(buffer, out.len);
+}
+
+uint32_t format_str(char *buf, uint32_t size, const char *fmt, ...) {
+    if (!size)
+        return 0;
+    print_out_t out = {buf, 0, size - 1, 0};
+
+    va_list args;
+    va_start(args, fmt);
+    print_format(&out, fmt, args);
+    va_end(args);
+
+    buf[out.len] = '\0';
+    return out.len;
 }
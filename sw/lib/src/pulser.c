@@ -7,8 +7,14 @@
 
 #include "util.h"
 #include "config.h"
+#include "irq.h"
 #include "pulser.h"
 
+static pulser_done_handler_t pulser_done_handler;
+
+// Copy of the EN mask in PULSER_GENERAL_CFG (reset value 0), saves the bus read of pulser_en/dis
+static uint32_t pulser_en_shadow;
+
 // Low-level register access helpers
 static inline void pulser_write(pulser_id_t id, int reg_offset, int value)
 {
@@ -20,44 +26,62 @@ static inline int pulser_read(pulser_id_t id, int reg_offset)
     return *reg32(PULSER_BASE_ADDR, reg_offset + id * PULSER_OFFSET_PER_ID);
 }
 
-uint32_t bitfield_get_field32(bitfield_field32_t field, uint32_t reg)
+// Register values, shared by the direct configuration and the queue
+static inline uint32_t pulser_f1_reg(int endvalue, int switchvalue)
 {
-    return (reg >> field.index) & field.mask;
+    uint32_t reg = 0;
+    reg = bitfield_set_field32(PULSER_CORE_CFG_F1_SWITCHVAL_FIELD, reg, (uint32_t)switchvalue);
+    reg = bitfield_set_field32(PULSER_CORE_CFG_F1_ENDVAL_FIELD, reg, (uint32_t)endvalue);
+    return reg;
+}
+
+static inline uint32_t pulser_f2_reg(int endvalue, int switchvalue)
+{
+    uint32_t reg = 0;
+    reg = bitfield_set_field32(PULSER_CORE_CFG_F2_SWITCHVAL_FIELD, reg, (uint32_t)switchvalue);
+    reg = bitfield_set_field32(PULSER_CORE_CFG_F2_ENDVAL_FIELD, reg, (uint32_t)endvalue);
+    return reg;
 }
 
-uint32_t bitfield_set_field32(bitfield_field32_t field, uint32_t reg, uint32_t value)
+static inline uint32_t pulser_cnt_reg(int n_f1, int n_f2, int n_stop)
 {
-    reg &= ~(field.mask << field.index);
-    reg |= ((value & field.mask) << field.index);
+    uint32_t reg = 0;
+    reg = bitfield_set_field32(PULSER_CORE_CFG_CNT_F1_FIELD, reg, (uint32_t)n_f1);
+    reg = bitfield_set_field32(PULSER_CORE_CFG_CNT_F2_FIELD, reg, (uint32_t)n_f2);
+    reg = bitfield_set_field32(PULSER_CORE_CFG_CNT_CNT_STOP_FIELD, reg, (uint32_t)n_stop);
+    return reg;
+}
+
+static inline uint32_t pulser_ctrl_out_reg(const pulser_settings_t *settings)
+{
+    uint32_t reg = 0;
+    if (settings->invert_out)
+    {
+        reg |= (1 << PULSER_CORE_CTRL_OUT_INVERT_OUT_BIT);
+    }
+    if (settings->idle_high)
+    {
+        reg |= (1 << PULSER_CORE_CTRL_OUT_IDLE_OUT_BIT);
+    }
     return reg;
 }
 
 // Set phase F1 end and switch values
 void pulser_set_f1_end_switch(pulser_id_t id, int endvalue, int switchvalue)
 {
-    int reg = 0;
-    reg = bitfield_set_field32(PULSER_CORE_CFG_F1_SWITCHVAL_FIELD, reg, (uint32_t)switchvalue);
-    reg = bitfield_set_field32(PULSER_CORE_CFG_F1_ENDVAL_FIELD, reg, (uint32_t)endvalue);
-    pulser_write(id, PULSER_CORE_CFG_F1_REG_OFFSET, reg);
+    pulser_write(id, PULSER_CORE_CFG_F1_REG_OFFSET, pulser_f1_reg(endvalue, switchvalue));
 }
 
 // Set phase F2 end and switch values
 void pulser_set_f2_end_switch(pulser_id_t id, int endvalue, int switchvalue)
 {
-    int reg = 0;
-    reg = bitfield_set_field32(PULSER_CORE_CFG_F2_SWITCHVAL_FIELD, reg, (uint32_t)switchvalue);
-    reg = bitfield_set_field32(PULSER_CORE_CFG_F2_ENDVAL_FIELD, reg, (uint32_t)endvalue);
-    pulser_write(id, PULSER_CORE_CFG_F2_REG_OFFSET, reg);
+    pulser_write(id, PULSER_CORE_CFG_F2_REG_OFFSET, pulser_f2_reg(endvalue, switchvalue));
 }
 
 // Set pulse counts for F1, F2 and stop
 void pulser_set_f1_f2_stop_count(pulser_id_t id, int n_f1, int n_f2, int n_stop)
 {
-    int reg = 0;
-    reg = bitfield_set_field32(PULSER_CORE_CFG_CNT_F1_FIELD, reg, (uint32_t)n_f1);
-    reg = bitfield_set_field32(PULSER_CORE_CFG_CNT_F2_FIELD, reg, (uint32_t)n_f2);
-    reg = bitfield_set_field32(PULSER_CORE_CFG_CNT_CNT_STOP_FIELD, reg, (uint32_t)n_stop);
-    pulser_write(id, PULSER_CORE_CFG_CNT_REG_OFFSET, reg);
+    pulser_write(id, PULSER_CORE_CFG_CNT_REG_OFFSET, pulser_cnt_reg(n_f1, n_f2, n_stop));
 }
 
 // Configure all pulser settings at once
@@ -72,36 +96,78 @@ void pulser_set_values(pulser_id_t id, const pulser_settings_t *settings)
 void pulser_config(pulser_id_t id, const pulser_settings_t *settings)
 {
     pulser_set_values(id, settings);
-    int reg = 0;
-    if (settings->invert_out)
+    pulser_write(id, PULSER_CORE_CTRL_OUT_REG_OFFSET, pulser_ctrl_out_reg(settings));
+}
+
+void pulser_image_make(pulser_image_t *image, const pulser_settings_t *settings)
+{
+    image->f1 = pulser_f1_reg(settings->f1_end, settings->f1_switch);
+    image->f2 = pulser_f2_reg(settings->f2_end, settings->f2_switch);
+    image->cnt = pulser_cnt_reg(settings->f1_count, settings->f2_count, settings->stop_count);
+    image->ctrl_out = pulser_ctrl_out_reg(settings);
+}
+
+// Stream precomputed images to the instances, four stores per instance
+void pulser_load_images(const pulser_image_t *images, uint32_t pulsers_to_load)
+{
+    volatile uint32_t *core = reg32(PULSER_BASE_ADDR, 0);
+    pulsers_to_load &= (1 << N_PULSERS) - 1;
+    for (; pulsers_to_load; pulsers_to_load >>= 1, core += PULSER_OFFSET_PER_ID / 4)
     {
-        reg |= (1 << PULSER_CORE_CTRL_OUT_INVERT_OUT_BIT);
+        if (!(pulsers_to_load & 1))
+        {
+            continue;
+        }
+        uint32_t f1 = images->f1;
+        uint32_t f2 = images->f2;
+        uint32_t cnt = images->cnt;
+        uint32_t ctrl_out = images->ctrl_out;
+        images++;
+        core[PULSER_CORE_CFG_F1_REG_OFFSET / 4] = f1;
+        core[PULSER_CORE_CFG_F2_REG_OFFSET / 4] = f2;
+        core[PULSER_CORE_CFG_CNT_REG_OFFSET / 4] = cnt;
+        core[PULSER_CORE_CTRL_OUT_REG_OFFSET / 4] = ctrl_out;
     }
-    if (settings->idle_high)
+}
+
+// Queue a configuration, the wrapper loads and starts it when the instance is IDLE or DONE
+int pulser_enqueue(pulser_id_t id, const pulser_settings_t *settings)
+{
+    if (*reg32(PULSER_BASE_ADDR, PULSER_QUEUE_FULL_REG_OFFSET) & (1 << id))
     {
-        reg |= (1 << PULSER_CORE_CTRL_OUT_IDLE_OUT_BIT);
+        return -1;
     }
-    pulser_write(id, PULSER_CORE_CTRL_OUT_REG_OFFSET, reg);
+    volatile uint32_t *stage = reg32(PULSER_BASE_ADDR, PULSER_QUEUE_STAGE_REG_OFFSET);
+    stage[0] = pulser_f1_reg(settings->f1_end, settings->f1_switch);
+    stage[1] = pulser_f2_reg(settings->f2_end, settings->f2_switch);
+    stage[2] = pulser_cnt_reg(settings->f1_count, settings->f2_count, settings->stop_count);
+    stage[3] = pulser_ctrl_out_reg(settings);
+    *reg32(PULSER_BASE_ADDR, PULSER_QUEUE_PUSH_REG_OFFSET) = 1 << id;
+    return 0;
+}
+
+int pulser_queue_level(pulser_id_t id)
+{
+    return *reg32(PULSER_BASE_ADDR, PULSER_QUEUE_LEVEL_REG_OFFSET + 4 * id);
+}
+
+void pulser_queue_flush(int pulsers_to_flush)
+{
+    *reg32(PULSER_BASE_ADDR, PULSER_QUEUE_FLUSH_REG_OFFSET) = pulsers_to_flush;
 }
 
 // Enable the pulser by writing to config register
 void pulser_en(int pulser_to_en)
 {
-    uint32_t offset_pulsers = PULSER_OFFSET_PER_ID * N_PULSERS;
-    volatile uint32_t *cfg_reg = (volatile uint32_t *)(PULSER_BASE_ADDR + offset_pulsers + PULSER_GENERAL_CFG_REG_OFFSET);
-
-    uint32_t regval = *cfg_reg;
-    *cfg_reg = regval | (pulser_to_en << PULSER_GENERAL_CFG_EN_OFFSET);
+    pulser_en_shadow |= (uint32_t)pulser_to_en << PULSER_GENERAL_CFG_EN_OFFSET;
+    *reg32(PULSER_BASE_ADDR, PULSER_OFFSET_PER_ID * N_PULSERS + PULSER_GENERAL_CFG_REG_OFFSET) = pulser_en_shadow;
 }
 
 // Disable the pulser by writing to config register
 void pulser_dis(int pulser_to_dis)
 {
-    uint32_t offset_pulsers = PULSER_OFFSET_PER_ID * N_PULSERS;
-    volatile uint32_t *cfg_reg = (volatile uint32_t *)(PULSER_BASE_ADDR + offset_pulsers + PULSER_GENERAL_CFG_REG_OFFSET);
-
-    uint32_t regval = *cfg_reg;
-    *cfg_reg = regval & ~(pulser_to_dis << PULSER_GENERAL_CFG_EN_OFFSET);
+    pulser_en_shadow &= ~((uint32_t)pulser_to_dis << PULSER_GENERAL_CFG_EN_OFFSET);
+    *reg32(PULSER_BASE_ADDR, PULSER_OFFSET_PER_ID * N_PULSERS + PULSER_GENERAL_CFG_REG_OFFSET) = pulser_en_shadow;
 }
 
 // Start the pulser by writing to control register
@@ -120,6 +186,59 @@ void pulser_stop(int pulser_to_stop)
     *ctrl_reg = ((uint32_t)(pulser_to_stop & PULSER_GENERAL_CTRL_STOP_MASK)) << PULSER_GENERAL_CTRL_STOP_OFFSET;
 }
 
+// Completion interrupt
+static void pulser_irq_handler(void)
+{
+    uint32_t done = pulser_irq_pending() & *reg32(PULSER_BASE_ADDR, PULSER_IRQ_MASK_REG_OFFSET);
+    pulser_irq_clear(done);
+    if (pulser_done_handler)
+    {
+        pulser_done_handler(done);
+    }
+}
+
+void pulser_irq_enable(int pulsers_to_irq, pulser_done_handler_t handler)
+{
+    pulser_done_handler = handler;
+    pulser_irq_clear(pulsers_to_irq); // drop completions from before
+    *reg32(PULSER_BASE_ADDR, PULSER_IRQ_MASK_REG_OFFSET) |= pulsers_to_irq;
+    irq_register(IRQ_PULSER, pulser_irq_handler);
+}
+
+void pulser_irq_disable(int pulsers_to_mask)
+{
+    uint32_t mask = *reg32(PULSER_BASE_ADDR, PULSER_IRQ_MASK_REG_OFFSET) & ~pulsers_to_mask;
+    *reg32(PULSER_BASE_ADDR, PULSER_IRQ_MASK_REG_OFFSET) = mask;
+    if (!mask)
+    {
+        irq_register(IRQ_PULSER, 0);
+    }
+}
+
+uint32_t pulser_irq_pending(void)
+{
+    return *reg32(PULSER_BASE_ADDR, PULSER_IRQ_PENDING_REG_OFFSET);
+}
+
+void pulser_irq_clear(uint32_t done_mask)
+{
+    *reg32(PULSER_BASE_ADDR, PULSER_IRQ_PENDING_REG_OFFSET) = done_mask;
+}
+
+// Trigger crossbar
+void pulser_trigger_route(int src, int pulsers_to_start, int pulsers_to_stop)
+{
+    *reg32(PULSER_BASE_ADDR, PULSER_TRIG_ROUTE_REG_OFFSET + 4 * src) =
+        ((uint32_t)pulsers_to_stop << 16) | ((uint32_t)pulsers_to_start & 0xFFFF);
+}
+
+void pulser_trigger_gpio(int k, int pin, int rising, int falling)
+{
+    uint32_t cfg = *reg32(PULSER_BASE_ADDR, PULSER_TRIG_GPIO_REG_OFFSET) & ~(0x7Fu << (8 * k));
+    cfg |= ((pin & 0x1F) | (rising ? 1 << 5 : 0) | (falling ? 1 << 6 : 0)) << (8 * k);
+    *reg32(PULSER_BASE_ADDR, PULSER_TRIG_GPIO_REG_OFFSET) = cfg;
+}
+
 // void pulser_disable_all_after_done(void)
 // {
 //     for (int i_pulser = 0; i_pulser < N_PULSERS; ++i_pulser) {
@@ -159,6 +278,11 @@ int pulser_read_count(pulser_id_t id)
     return pulser_read(id, PULSER_CORE_CFG_CNT_REG_OFFSET);
 }
 
+int pulser_read_ctrl_out(pulser_id_t id)
+{
+    return pulser_read(id, PULSER_CORE_CTRL_OUT_REG_OFFSET);
+}
+
 // int pulser_read_status(pulser_id_t id)
 // {
 //     int reg = pulser_read(id, PULSER_CORE_STATUS_REG_OFFSET);
@@ -0,0 +1,37 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include <stdint.h>
+#include "string.h"
+
+// GCC may turn byte loops into calls to the function they implement, which would recurse here
+#define STRING_LOOP __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+STRING_LOOP void *memmove(void *dst, const void *src, size_t n) {
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+    // memcpy copies upwards, which is safe unless dst overlaps the end of src
+    if (d <= s || d >= s + n)
+        return memcpy(dst, src, n);
+    while (n--)
+        d[n] = s[n];
+    return dst;
+}
+
+STRING_LOOP size_t strlen(const char *s) {
+    const char *end = s;
+    while (*end)
+        end++;
+    return end - s;
+}
+
+int strcmp(const char *a, const char *b) {
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return (uint8_t)*a - (uint8_t)*b;
+}
@@ -0,0 +1,89 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "task.h"
+#include "timer.h"
+#include "irq.h"
+#include "util.h"
+#include "config.h"
+
+static task_t task_table[TASK_MAX];
+static volatile uint8_t task_pending; // task_signal() since the start of the round
+uint8_t task_progress;
+
+task_t *task_create(task_fn_t fn, void *arg) {
+    for (task_t *t = task_table; t < task_table + TASK_MAX; t++) {
+        if (t->fn)
+            continue;
+        t->fn = fn;
+        t->arg = arg;
+        t->lc = 0;
+        t->events = 0;
+        t->timer.next = 0;
+        return t;
+    }
+    return 0;
+}
+
+void task_signal(task_t *t, uint32_t events) {
+    uint32_t mie = irq_lock();
+    t->events |= events;
+    task_pending = 1;
+    irq_unlock(mie);
+}
+
+static void task_timer_wake(void *arg) {
+    task_signal(arg, TASK_EV_TIMER);
+}
+
+void task_sleep_start(task_t *t, uint32_t us) {
+    t->events &= ~TASK_EV_TIMER;
+    timer_add(&t->timer, us, 0, task_timer_wake, t);
+}
+
+uint32_t task_run(void) {
+    uint32_t idle = 0;
+    timer_init();
+    uint32_t mie = irq_lock();
+    for (;;) {
+        set_mie(1); // serve the pending interrupts, they signal the tasks
+        set_mie(0);
+        timer_poll();
+
+        task_pending = 0;
+        task_progress = 0;
+        int alive = 0;
+        for (task_t *t = task_table; t < task_table + TASK_MAX; t++) {
+            if (!t->fn)
+                continue;
+            int ret = t->fn(t);
+            if (ret == TASK_EXITED) {
+                timer_cancel(&t->timer);
+                t->fn = 0;
+            } else {
+                alive = 1;
+                if (ret == TASK_YIELDED)
+                    task_progress = 1;
+            }
+        }
+        if (!alive)
+            break;
+        if (task_progress || task_pending)
+            continue;
+
+        // Every task waits. Timer compare matches are pulses that got lost while interrupts
+        // were disabled, so expired timers are run here before going to sleep. wfi with
+        // interrupts disabled still wakes up on a pending interrupt.
+        timer_poll();
+        if (task_pending)
+            continue;
+        uint32_t start = timer_now_us();
+        wfi();
+        idle += timer_now_us() - start;
+    }
+    irq_unlock(mie);
+    return idle;
+}
@@ -10,6 +10,7 @@
 #include "util.h"
 #include "uart.h"
 #include "print.h"
+#include "gpio.h"
 
 
 #if TEST_NOP
@@ -109,60 +110,21 @@ void test_pulser_regs(pulser_id_t id)
 }
 #endif
 
-#if TEST_RUN_PULSER_ONE_BY_ONE || TEST_RUN_ALL_PULSERS
+#if TEST_RUN_PULSER_ONE_BY_ONE || TEST_RUN_ALL_PULSERS || TEST_RUN_PULSER_IRQ || TEST_RUN_PULSER_TRIGGER
+// images of the four test waveforms, instances 4..7 repeat those of 0..3
+static const pulser_image_t testconf_images[N_PULSERS] = {
+    PULSER_IMAGE(7, 3, 9, 6, 8, 5, 2, 0, 0),
+    PULSER_IMAGE(8, 4, 6, 2, 1, 9, 3, 0, 0),
+    PULSER_IMAGE(9, 5, 7, 3, 2, 4, 6, 0, 0),
+    PULSER_IMAGE(6, 2, 8, 5, 7, 1, 9, 0, 0),
+    PULSER_IMAGE(7, 3, 9, 6, 8, 5, 2, 0, 0),
+    PULSER_IMAGE(8, 4, 6, 2, 1, 9, 3, 0, 0),
+    PULSER_IMAGE(9, 5, 7, 3, 2, 4, 6, 0, 0),
+    PULSER_IMAGE(6, 2, 8, 5, 7, 1, 9, 0, 0),
+};
+
 static inline void set_testconf(void) {
-    pulser_settings_t pulser0_settings;
-    pulser0_settings.f1_end = 7;
-    pulser0_settings.f1_switch = 3;
-    pulser0_settings.f2_end = 9;
-    pulser0_settings.f2_switch = 6;
-    pulser0_settings.f1_count = 8;
-    pulser0_settings.f2_count = 5;
-    pulser0_settings.stop_count = 2;
-    pulser0_settings.invert_out = 0;
-    pulser0_settings.idle_high = 0;
-
-    pulser_settings_t pulser1_settings;
-    pulser1_settings.f1_end = 8;
-    pulser1_settings.f1_switch = 4;
-    pulser1_settings.f2_end = 6;
-    pulser1_settings.f2_switch = 2;
-    pulser1_settings.f1_count = 1;
-    pulser1_settings.f2_count = 9;
-    pulser1_settings.stop_count = 3;
-    pulser1_settings.invert_out = 0;
-    pulser1_settings.idle_high = 0;
-
-    pulser_settings_t pulser2_settings;
-    pulser2_settings.f1_end = 9;
-    pulser2_settings.f1_switch = 5;
-    pulser2_settings.f2_end = 7;
-    pulser2_settings.f2_switch = 3;
-    pulser2_settings.f1_count = 2;
-    pulser2_settings.f2_count = 4;
-    pulser2_settings.stop_count = 6;
-    pulser2_settings.invert_out = 0;
-    pulser2_settings.idle_high = 0;
-
-    pulser_settings_t pulser3_settings;
-    pulser3_settings.f1_end = 6;
-    pulser3_settings.f1_switch = 2;
-    pulser3_settings.f2_end = 8;
-    pulser3_settings.f2_switch = 5;
-    pulser3_settings.f1_count = 7;
-    pulser3_settings.f2_count = 1;
-    pulser3_settings.stop_count = 9;
-    pulser3_settings.invert_out = 0;
-    pulser3_settings.idle_high = 0;
-    
-    pulser_config(PULSER_0, &pulser0_settings);
-    pulser_config(PULSER_1, &pulser1_settings);
-    pulser_config(PULSER_2, &pulser2_settings);
-    pulser_config(PULSER_3, &pulser3_settings);
-    pulser_config(PULSER_4, &pulser0_settings);
-    pulser_config(PULSER_5, &pulser1_settings);
-    pulser_config(PULSER_6, &pulser2_settings);
-    pulser_config(PULSER_7, &pulser3_settings);
+    pulser_load_images(testconf_images, 0xFF);
 }
 #endif
 
@@ -218,6 +180,92 @@ void test_pulser_run_all(void) {
 }
 #endif
 
+#if TEST_RUN_PULSER_QUEUE
+void test_pulser_queue(void) {
+    // alternate two different trains on pulser 0, played back to back by the queue, the last
+    // one idles high so its CTRL_OUT word must reach the core as well
+    pulser_settings_t trains[3] = {
+        {.f1_end = 7, .f1_switch = 3, .f2_end = 9, .f2_switch = 6, .f1_count = 4, .f2_count = 2,
+         .stop_count = 1},
+        {.f1_end = 3, .f1_switch = 1, .f2_end = 5, .f2_switch = 2, .f1_count = 6, .f2_count = 3,
+         .stop_count = 1},
+        {.f1_end = 5, .f1_switch = 2, .f2_end = 4, .f2_switch = 1, .f1_count = 3, .f2_count = 3,
+         .stop_count = 1, .idle_high = 1}};
+    int max_level = 0;
+
+    pulser_queue_flush(0xFF);
+    pulser_en(1 << PULSER_0);
+    for (int i = 0; i < 5; i++) {
+        while (pulser_enqueue(PULSER_0, &trains[i & 1]) != 0)
+            ; // full
+        int level = pulser_queue_level(PULSER_0);
+        if (level > max_level) max_level = level;
+    }
+    while (pulser_enqueue(PULSER_0, &trains[2]) != 0)
+        ;
+    while (pulser_queue_level(PULSER_0) != 0)
+        ;
+    while (get_pulser_fsm_state(PULSER_0) != DONE)
+        ;
+    printf("Pulser queue: max level %x, last f1_end %x (expected %x)\n", max_level,
+           pulser_read_f1_end(PULSER_0), trains[2].f1_end);
+    printf("Pulser queue: last ctrl_out %x (expected %x)\n", pulser_read_ctrl_out(PULSER_0),
+           1 << PULSER_CORE_CTRL_OUT_IDLE_OUT_BIT);
+    uart_write_flush();
+}
+#endif
+
+#if TEST_RUN_PULSER_IRQ
+static volatile uint32_t pulsers_done;
+
+static void test_pulser_done(uint32_t done_mask) {
+    pulsers_done |= done_mask;
+}
+
+void test_pulser_irq(void) {
+    // run all pulsers, then sleep until every one reported DONE through IRQ_PULSER
+    set_testconf();
+    pulsers_done = 0;
+    pulser_irq_enable(0xFF, test_pulser_done);
+    set_mie(1);
+    pulser_en(0xFF);
+    pulser_start(0xFF);
+    // check and wfi with interrupts disabled, the pending interrupt still ends wfi
+    set_mie(0);
+    while (pulsers_done != 0xFF) {
+        wfi();
+        set_mie(1); // serve the pending interrupts
+        set_mie(0);
+    }
+    pulser_irq_disable(0xFF);
+    printf("Pulsers done: %x\n", pulsers_done);
+    uart_write_flush();
+}
+#endif
+
+#if TEST_RUN_PULSER_TRIGGER
+void test_pulser_trigger(void) {
+    // start all pulsers on the first event of adv timer 0 channel 0, without the CPU
+    set_testconf();
+    pulser_en(0xFF);
+    pulser_trigger_route(PULSER_TRIG_SRC_ADV_EVENT(0), 0xFF, 0);
+    timer0_init(0x10);
+    adv_timer_enable_event(0, 0);
+    adv_timer_start(0);
+
+    // all instances started in the same cycle, so they report DONE together
+    int done = 0;
+    while (!done) {
+        done = 1;
+        for (int id = 0; id < N_PULSERS; id++)
+            done &= get_pulser_fsm_state(id) == DONE;
+    }
+    pulser_trigger_route(PULSER_TRIG_SRC_ADV_EVENT(0), 0, 0);
+    printf("Pulsers triggered by adv timer event\n");
+    uart_write_flush();
+}
+#endif
+
 #if TEST_RUN_ADV_TIMER
 void test_adv_timer(void) {
     // Read Signature from ROM
@@ -272,3 +320,87 @@ void test_adv_timer_interrupt(void) {
 
 }
 #endif
+
+#if TEST_RUN_ADV_TIMER_CAPTURE
+static volatile int capture_ready;
+
+static void test_capture_full(void) {
+    capture_ready = 1;
+    adv_timer_capture_disable(); // keep the entries, stop further interrupts
+}
+
+void test_adv_timer_capture(void) {
+    // GPIO 0 is looped back to GPIO 4 in the testbench, capture both edges of two pulses on it
+    uint32_t entries[4];
+    gpio_set_direction(1 << 0, 1 << 0);
+    gpio_enable(1 << 0);
+    gpio_pin_clear(0);
+    capture_ready = 0;
+    adv_timer_capture_init(4, 1, 1, 4, test_capture_full);
+    set_mie(1);
+
+    for (int i = 0; i < 2; i++) {
+        gpio_pin_set(0);
+        for (volatile int d = 0; d < 4; d++)
+            ;
+        gpio_pin_clear(0);
+        for (volatile int d = 0; d < 8; d++)
+            ;
+    }
+    // check and wfi with interrupts disabled, the pending interrupt still ends wfi
+    set_mie(0);
+    while (!capture_ready) {
+        wfi();
+        set_mie(1); // serve the pending interrupts
+        set_mie(0);
+    }
+
+    int n = adv_timer_capture_read(entries, 4);
+    printf("Captured %x edges, first rising: %x\n", n, CAP_RISING(entries[0]));
+    printf("High: 0x%x cycles, period: 0x%x cycles\n", CAP_DELTA(entries[1], entries[0]),
+           CAP_DELTA(entries[2], entries[0]));
+    // all entries valid, a read of the empty FIFO is not
+    printf("Valid: %x, empty read: %x\n",
+           CAP_VALID(entries[0] & entries[1] & entries[2] & entries[3]),
+           CAP_VALID(*reg32(ADV_TIMER_BASE_ADDR, REG_CAP_DATA)));
+    uart_write_flush();
+}
+#endif
+
+#if TEST_RUN_DMA_MODES
+static const uint32_t dma_test_src[4] = {0x11223344, 0x55667788, 0x99AABBCC, 0xDDEEFF00};
+static volatile uint32_t dma_test_dst[4];
+
+static int test_dma_check_copy(void) {
+    int n_errors = 0;
+    for (int i = 0; i < 4; i++)
+        if (dma_test_dst[i] != dma_test_src[i]) n_errors++;
+    return n_errors;
+}
+
+void test_dma_modes(void) {
+    // three transfers that each change SIZE and DST_FIXED, every one must run with the mode of
+    // its own dma_start() and not with the one of the transfer before
+    int n_errors = 0;
+
+    for (int i = 0; i < 4; i++) dma_test_dst[i] = 0;
+    dma_start(dma_test_dst, dma_test_src, 16, DMA_MEM_TO_MEM, DMA_SIZE_WORD);
+    if (dma_wait()) n_errors++;
+    n_errors += test_dma_check_copy();
+
+    // bytes into one fixed word: all land in byte lane 0 of dma_test_dst[0], the last one stays
+    for (int i = 0; i < 4; i++) dma_test_dst[i] = 0;
+    dma_start(dma_test_dst, dma_test_src, 4, DMA_MEM_TO_PERIPH, DMA_SIZE_BYTE);
+    if (dma_wait()) n_errors++;
+    if (dma_test_dst[0] != (dma_test_src[0] >> 24)) n_errors++;
+    for (int i = 1; i < 4; i++)
+        if (dma_test_dst[i] != 0) n_errors++;
+
+    dma_start(dma_test_dst, dma_test_src, 16, DMA_MEM_TO_MEM, DMA_SIZE_WORD);
+    if (dma_wait()) n_errors++;
+    n_errors += test_dma_check_copy();
+
+    printf("DMA modes: N Errors: %x\n", n_errors);
+    uart_write_flush();
+}
+#endif
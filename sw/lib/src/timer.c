@@ -3,36 +3,144 @@
 // SPDX-License-Identifier: Apache-2.0
 //
 // Philippe Sauter <phsauter@iis.ee.ethz.ch>
+// Nico Canzani <ncanzani@student.ethz.ch>
 
 #include "timer.h"
+#include "irq.h"
 #include "util.h"
 #include "config.h"
 
-void sleep_ms(uint32_t ms) {
+static sw_timer_t *timer_list; // sorted by deadline
+static int timer_running;
+
+// Deadline comparison across the counter wrap
+static inline int32_t timer_diff(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b);
+}
+
+uint32_t timer_now_us(void) {
+    return *reg32(TIMER_BASE_ADDR, TIMER_VALUE_LOW_REG_OFFSET);
+}
+
+static void timer_insert(sw_timer_t *t) {
+    sw_timer_t **pos = &timer_list;
+    while (*pos && timer_diff((*pos)->deadline, t->deadline) <= 0)
+        pos = &(*pos)->next;
+    t->next = *pos;
+    *pos = t;
+}
+
+static void timer_remove(sw_timer_t *t) {
+    for (sw_timer_t **pos = &timer_list; *pos; pos = &(*pos)->next) {
+        if (*pos == t) {
+            *pos = t->next;
+            return;
+        }
+    }
+}
+
+// Run the expired timers and arm the comparator for the next one, interrupts disabled.
+// The comparator only matches on equality, so deadlines that are too close to be armed
+// safely are waited out here, as are deadlines the counter passed while arming.
+static void timer_service(void) {
+    while (timer_list) {
+        sw_timer_t *t = timer_list;
+        if (timer_diff(t->deadline, timer_now_us()) >= TIMER_MIN_DELTA_US) {
+            *reg32(TIMER_BASE_ADDR, TIMER_CMP_LOW_REG_OFFSET) = t->deadline;
+            if (timer_diff(t->deadline, timer_now_us()) > 0)
+                return;
+        }
+        while (timer_diff(t->deadline, timer_now_us()) > 0)
+            ;
+        timer_list = t->next;
+        if (t->period) {
+            t->deadline += t->period;
+            timer_insert(t);
+        }
+        t->callback(t->arg);
+    }
+}
+
+static void timer_irq_handler(void) {
+    timer_service();
+}
+
+void timer_init(void) {
+    if (timer_running)
+        return;
     uint32_t config = \
-        (1 << CFG_LOW_REG_CLOCK_SOURCE_BIT) | // from 32.768 kHz ref clock
-        (1 << CFG_LOW_REG_PRESC_ENABLE_BIT) | // enable prescaler
-        (31 << CFG_LOW_REG_PRESC_VALUE_BIT) | // prescaler value
-        (1 << CFG_LOW_REG_CMP_CLR_BIT)      | // auto-clear
-        (1 << CFG_LOW_REG_IRQ_ENABLE_BIT)   | // enable IRQ
-        (1 << CFG_LOW_REG_ENABLE_BIT);        // enable timer
-
-    // disable timer
+        (0 << CFG_LOW_REG_CLOCK_SOURCE_BIT)                          | // system clock
+        (1 << CFG_LOW_REG_PRESC_ENABLE_BIT)                          | // enable prescaler
+        ((TIMER_TICKS_PER_US - 1) << CFG_LOW_REG_PRESC_VALUE_BIT)    | // 1 us ticks
+        (1 << CFG_LOW_REG_IRQ_ENABLE_BIT)                            | // enable IRQ
+        (1 << CFG_LOW_REG_ENABLE_BIT);                                 // enable timer, free running
+
     *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = 0;
+    *reg32(TIMER_BASE_ADDR, TIMER_RESET_LOW_REG_OFFSET) = 1;
+    *reg32(TIMER_BASE_ADDR, TIMER_CMP_LOW_REG_OFFSET) = 0xFFFFFFFF;
+    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = config;
+    timer_list = 0;
+    timer_running = 1;
+    irq_register(IRQ_TIMER, timer_irq_handler);
+}
 
-    *reg32(TIMER_BASE_ADDR, TIMER_CMP_LOW_REG_OFFSET) = ms;
+void timer_add(sw_timer_t *t, uint32_t delay_us, uint32_t period_us, timer_callback_t callback,
+               void *arg) {
+    timer_init();
+    uint32_t mie = irq_lock();
+    timer_remove(t);
+    t->deadline = timer_now_us() + delay_us;
+    t->period = period_us;
+    t->callback = callback;
+    t->arg = arg;
+    timer_insert(t);
+    timer_service();
+    irq_unlock(mie);
+}
 
-    set_mtie(1);  // Machine Timer Interrupt Enable
-    set_mie(1);  // Global Interrupt Enable
+void timer_cancel(sw_timer_t *t) {
+    uint32_t mie = irq_lock();
+    timer_remove(t);
+    timer_service();
+    irq_unlock(mie);
+}
 
-    // start timer
-    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = config;
+void timer_poll(void) {
+    uint32_t mie = irq_lock();
+    timer_service();
+    irq_unlock(mie);
+}
 
-    asm volatile("wfi");
+void timer_poll_locked(void) {
+    // nothing expired: the comparator is still armed for the first timer
+    if (timer_list && timer_diff(timer_list->deadline, timer_now_us()) <= 0)
+        timer_service();
+}
+
+static void timer_wake(void *arg) {
+    *(volatile int *)arg = 1;
+}
 
-    // turn off timer
-    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) &= ~(1 << CFG_LOW_REG_ENABLE_BIT);
+void timer_sleep_us(uint32_t us) {
+    volatile int done = 0;
+    sw_timer_t t;
+    t.next = 0;
+    timer_add(&t, us, 0, timer_wake, (void *)&done);
 
-    // disable timer interrupt
-    set_mtie(0);
+    // wfi with interrupts disabled still wakes up on a pending interrupt, so the comparator
+    // match cannot slip in between the check and the wfi
+    uint32_t mie = irq_lock();
+    while (!done) {
+        timer_service();
+        if (done)
+            break;
+        wfi();
+        set_mie(1); // serve the pending interrupts
+        set_mie(0);
+    }
+    irq_unlock(mie);
+}
+
+void sleep_ms(uint32_t ms) {
+    timer_sleep_us(ms * 1000);
 }
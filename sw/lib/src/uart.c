@@ -7,10 +7,24 @@
 
 #include "uart.h"
 #include "util.h"
+#include "irq.h"
 #include "config.h"
 
 #define UART_DIVISOR(freq, baud) ((freq) / ((baud) << 4))  // Divisor calculation
 
+#define UART_TX_BUF_MASK (UART_TX_BUF_SIZE - 1)
+#define UART_RX_BUF_MASK (UART_RX_BUF_SIZE - 1)
+
+// Ring buffers of the interrupt-driven mode. The indices are free-running, the producer only
+// writes head and the consumer only writes tail, so no locking is needed between ISR and main.
+static volatile uint8_t uart_tx_buf[UART_TX_BUF_SIZE];
+static volatile uint8_t uart_rx_buf[UART_RX_BUF_SIZE];
+static volatile uint8_t uart_tx_head, uart_tx_tail;
+static volatile uint8_t uart_rx_head, uart_rx_tail;
+
+static volatile uint8_t uart_ier; // shadow of the interrupt enable register
+static uint8_t uart_async;        // set once uart_async_enable() was called
+
 void uart_init() {
     const uint16_t divisor = UART_DIVISOR(UART_FREQ, UART_BAUD); // Calculate from provided config
     uint8_t dlo = (uint8_t)(divisor);
@@ -49,6 +63,36 @@ static inline int __uart_write_idle() {
            *reg8(UART_BASE_ADDR, UART_LINE_STATUS_REG_OFFSET) & (1 << UART_LINE_STATUS_TMIT_EMPTY_BIT);
 }
 
+static int uart_tx_pending() {
+    return uart_tx_head != uart_tx_tail;
+}
+
+static int uart_tx_full() {
+    return uart_write_space() == 0;
+}
+
+static int uart_rx_empty() {
+    return uart_rx_head == uart_rx_tail;
+}
+
+// Wait while busy() holds in interrupt-driven mode. The check and wfi run with interrupts
+// disabled so uart_irq_handler() cannot slip in between, the pending interrupt ends wfi and is
+// taken at irq_unlock(). If the caller already runs with interrupts disabled (interrupt handler,
+// timer callback, irq_lock(), task) wfi would never return, the UART is polled instead.
+static void uart_async_wait(int (*busy)()) {
+    uint32_t key = irq_lock();
+    while (busy()) {
+        if (key) {
+            wfi();
+            irq_unlock(key);
+            irq_lock();
+        } else {
+            uart_irq_handler();
+        }
+    }
+    irq_unlock(key);
+}
+
 void uart_write(uint8_t byte) {
     while (!__uart_write_ready())
         ;
@@ -56,10 +100,29 @@ void uart_write(uint8_t byte) {
 }
 
 void uart_write_str(void *src, uint32_t len) {
-    for (uint32_t i = 0; i < len; ++i) uart_write(((uint8_t *)src)[i]);
+    const uint8_t *bytes = src;
+    if (uart_async) {
+        while (len) {
+            uint32_t n = uart_write_async(bytes, len);
+            bytes += n;
+            len -= n;
+            if (len) uart_async_wait(uart_tx_full);
+        }
+        return;
+    }
+    // THR empty means the whole TX FIFO is free, fill it in one go
+    while (len) {
+        while (!__uart_write_ready())
+            ;
+        uint32_t n = len < UART_FIFO_DEPTH ? len : UART_FIFO_DEPTH;
+        len -= n;
+        while (n--)
+            *reg8(UART_BASE_ADDR, UART_THR_REG_OFFSET) = *bytes++;
+    }
 }
 
 void uart_write_flush() {
+    uart_async_wait(uart_tx_pending);
     while (!__uart_write_idle())
         ;
 }
@@ -75,9 +138,93 @@ void uart_read_str(void *dst, uint32_t len) {
 }
 
 void putchar(char byte) {
-    uart_write(byte);
+    if (uart_async) {
+        while (!uart_write_async(&byte, 1))
+            uart_async_wait(uart_tx_full);
+    } else {
+        uart_write(byte);
+    }
 };
 
 char getchar() {
+    if (uart_async) {
+        char byte;
+        while (!uart_read_async(&byte, 1))
+            uart_async_wait(uart_rx_empty);
+        return byte;
+    }
     return uart_read();
 };
+
+void uart_async_enable() {
+    uart_write_flush();
+    uart_ier = (1 << UART_INTR_ENABLE_DATA_READY_BIT);
+    *reg8(UART_BASE_ADDR, UART_FIFO_CONTROL_REG_OFFSET) = 0x07; // Enable & clear FIFO, 1B threshold
+    *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET)  = uart_ier;
+    uart_async = 1;
+    irq_register(IRQ_UART, uart_irq_handler);
+    set_mie(1);
+}
+
+uint32_t uart_write_async(const void *src, uint32_t len) {
+    uint8_t head = uart_tx_head;
+    uint32_t space = UART_TX_BUF_SIZE - (uint8_t)(head - uart_tx_tail);
+    if (len > space) len = space;
+    if (len == 0) return 0;
+
+    for (uint32_t i = 0; i < len; ++i)
+        uart_tx_buf[(head++) & UART_TX_BUF_MASK] = ((const uint8_t *)src)[i];
+    uart_tx_head = head;
+
+    // The ISR only disables the THR empty interrupt once the buffer is empty, so if it is
+    // still enabled here it will also pick up the new bytes.
+    if (!(uart_ier & (1 << UART_INTR_ENABLE_THR_EMPTY_BIT))) {
+        uint32_t mie = irq_lock();
+        uart_ier |= (1 << UART_INTR_ENABLE_THR_EMPTY_BIT);
+        *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET) = uart_ier;
+        irq_unlock(mie);
+    }
+    return len;
+}
+
+uint32_t uart_write_space() {
+    return UART_TX_BUF_SIZE - (uint8_t)(uart_tx_head - uart_tx_tail);
+}
+
+uint32_t uart_read_avail() {
+    return (uint8_t)(uart_rx_head - uart_rx_tail);
+}
+
+uint32_t uart_read_async(void *dst, uint32_t len) {
+    uint8_t tail = uart_rx_tail;
+    uint32_t avail = (uint8_t)(uart_rx_head - tail);
+    if (len > avail) len = avail;
+
+    for (uint32_t i = 0; i < len; ++i)
+        ((uint8_t *)dst)[i] = uart_rx_buf[(tail++) & UART_RX_BUF_MASK];
+    uart_rx_tail = tail;
+    return len;
+}
+
+void uart_irq_handler() {
+    // Receive: drain the RX FIFO into the ring buffer, bytes are dropped if it is full
+    while (uart_read_ready()) {
+        uint8_t byte = *reg8(UART_BASE_ADDR, UART_RBR_REG_OFFSET);
+        if ((uint8_t)(uart_rx_head - uart_rx_tail) < UART_RX_BUF_SIZE)
+            uart_rx_buf[(uart_rx_head++) & UART_RX_BUF_MASK] = byte;
+    }
+
+    // Transmit: THR empty means the whole TX FIFO is empty, refill up to its depth
+    if ((uart_ier & (1 << UART_INTR_ENABLE_THR_EMPTY_BIT)) && __uart_write_ready()) {
+        uint8_t tail = uart_tx_tail;
+        uint8_t head = uart_tx_head;
+        for (int n = 0; n < UART_FIFO_DEPTH && tail != head; ++n)
+            *reg8(UART_BASE_ADDR, UART_THR_REG_OFFSET) = uart_tx_buf[(tail++) & UART_TX_BUF_MASK];
+        uart_tx_tail = tail;
+
+        if (tail == uart_tx_head) {
+            uart_ier &= ~(1 << UART_INTR_ENABLE_THR_EMPTY_BIT);
+            *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET) = uart_ier;
+        }
+    }
+}
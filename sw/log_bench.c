@@ -0,0 +1,45 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Deferred logging benchmark: the same status line once with printf and once with LOG() (log.h),
+// each timed until the UART is idle again, so the cycles are dominated by the time on the wire.
+// The LOG() lines show up decoded in the testbench, or run sw/scripts/log_decode.py on the
+// captured UART output.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "log.h"
+#include "adv_timer.h"
+#include "util.h"
+#include "config.h"
+
+int main() {
+    uart_init();
+    uint32_t start, cycles_printf, cycles_log;
+
+    timer0_pwm_init(100, 30);
+    adv_timer_start(0);
+    int counter = timer0_get_counter();
+
+    uart_write_flush();
+    start = (uint32_t)get_mcycle();
+    printf("timer0: counter %u, top %u, bottom %u, th %u\n", counter, timer0_get_top_value(),
+           timer0_get_bottom_value(), adv_timer_get_threshold(0, 0));
+    uart_write_flush();
+    cycles_printf = (uint32_t)get_mcycle() - start;
+
+    start = (uint32_t)get_mcycle();
+    LOG("timer0: counter %u, top %u, bottom %u, th %u\n", counter, timer0_get_top_value(),
+        timer0_get_bottom_value(), adv_timer_get_threshold(0, 0));
+    uart_write_flush();
+    cycles_log = (uint32_t)get_mcycle() - start;
+
+    adv_timer_stop(0);
+    printf("printf: %u cycles, LOG: %u cycles\n", cycles_printf, cycles_log);
+
+    uart_write_flush();
+    return 1;
+}
@@ -0,0 +1,131 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Benchmark of the freestanding memory and multiply/divide routines (string.h, muldiv.S).
+// memcpy/memset/memcmp are compared against plain byte loops for several sizes and alignments.
+// The * / % operators call __mulsi3/__udivsi3/... on RV32I, run the binary once as is and once
+// built with `make LIBGCC_MULDIV=1` to compare against the libgcc versions.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "string.h"
+#include "util.h"
+#include "config.h"
+
+#define BENCH_BYTES 128
+#define BENCH_N     16
+
+static uint8_t bench_src[BENCH_BYTES + 4];
+static uint8_t bench_dst[BENCH_BYTES + 4];
+
+// inputs are volatile so the compiler cannot fold the kernels at compile time
+static volatile uint32_t bench_a[BENCH_N];
+static volatile uint32_t bench_b[BENCH_N];
+
+// the reference loops must not be turned into memcpy/memset calls by the compiler
+#define BENCH_LOOP __attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+
+BENCH_LOOP static void copy_bytes(uint8_t *dst, const uint8_t *src, uint32_t n) {
+    while (n--)
+        *dst++ = *src++;
+}
+
+BENCH_LOOP static void set_bytes(uint8_t *dst, uint8_t c, uint32_t n) {
+    while (n--)
+        *dst++ = c;
+}
+
+static void bench_mem(uint32_t n, uint32_t offset) {
+    uint32_t start, loop, lib;
+
+    start = (uint32_t)get_mcycle();
+    copy_bytes(bench_dst + offset, bench_src, n);
+    loop = (uint32_t)get_mcycle() - start;
+    start = (uint32_t)get_mcycle();
+    memcpy(bench_dst + offset, bench_src, n);
+    lib = (uint32_t)get_mcycle() - start;
+    printf("memcpy %3u +%u: loop %5u, lib %5u cycles\n", n, offset, loop, lib);
+
+    start = (uint32_t)get_mcycle();
+    set_bytes(bench_dst + offset, 0x5A, n);
+    loop = (uint32_t)get_mcycle() - start;
+    start = (uint32_t)get_mcycle();
+    memset(bench_dst + offset, 0x5A, n);
+    lib = (uint32_t)get_mcycle() - start;
+    printf("memset %3u +%u: loop %5u, lib %5u cycles\n", n, offset, loop, lib);
+}
+
+static void bench_cmp(uint32_t n) {
+    uint32_t start, loop, lib;
+    int result = 0;
+
+    memcpy(bench_dst, bench_src, n);
+    start = (uint32_t)get_mcycle();
+    for (uint32_t i = 0; i < n && !result; i++)
+        result = bench_dst[i] - bench_src[i];
+    loop = (uint32_t)get_mcycle() - start;
+    start = (uint32_t)get_mcycle();
+    result |= memcmp(bench_dst, bench_src, n);
+    lib = (uint32_t)get_mcycle() - start;
+    printf("memcmp %3u (equal %u): loop %5u, lib %5u cycles\n", n, !result, loop, lib);
+}
+
+// operands below 1 << bits
+static void bench_muldiv(uint32_t bits) {
+    uint32_t start, mul, div, mod;
+    uint32_t mask = bits < 32 ? (1u << bits) - 1 : 0xFFFFFFFF;
+    uint32_t acc = 0;
+
+    for (int i = 0; i < BENCH_N; i++) {
+        bench_a[i] = (0x9E3779B9u * (i + 1)) & mask;
+        bench_b[i] = ((0x7F4A7C15u * (i + 3)) & (mask >> 2)) | 1;
+    }
+
+    start = (uint32_t)get_mcycle();
+    for (int i = 0; i < BENCH_N; i++)
+        acc += bench_a[i] * bench_b[i];
+    mul = (uint32_t)get_mcycle() - start;
+
+    start = (uint32_t)get_mcycle();
+    for (int i = 0; i < BENCH_N; i++)
+        acc += bench_a[i] / bench_b[i];
+    div = (uint32_t)get_mcycle() - start;
+
+    start = (uint32_t)get_mcycle();
+    for (int i = 0; i < BENCH_N; i++)
+        acc += (int32_t)bench_a[i] % (int32_t)bench_b[i];
+    mod = (uint32_t)get_mcycle() - start;
+
+    printf("%2u bit: mul %5u, div %5u, mod %5u cycles (0x%x)\n", bits, mul, div, mod, acc);
+}
+
+int main() {
+    uart_init();
+
+    for (int i = 0; i < BENCH_BYTES; i++)
+        bench_src[i] = i;
+
+#ifdef __riscv_mul
+    printf("RV32M: hardware mul/div\n");
+#elif defined(LIBGCC_MULDIV)
+    printf("RV32I: libgcc mul/div\n");
+#else
+    printf("RV32I: muldiv.S\n");
+#endif
+
+    for (uint32_t n = 4; n <= BENCH_BYTES; n <<= 2) { // 4, 16, 64 bytes
+        bench_mem(n, 0);
+        bench_mem(n, 1);
+        bench_cmp(n);
+    }
+
+    bench_muldiv(8);
+    bench_muldiv(16);
+    bench_muldiv(32);
+
+    uart_write_flush();
+    return 1;
+}
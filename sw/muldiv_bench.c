@@ -0,0 +1,85 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Multiply/divide benchmark. Build the hardware and firmware with the same RV32M setting
+// (e.g. `make verilator RV32M=2`) and compare the cycle counts against RV32M=0, where every
+// `*`, `/` and `%` is a libgcc soft routine.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "config.h"
+
+#define BENCH_N 32
+
+// inputs are volatile so the compiler cannot fold the kernels at compile time
+static volatile int32_t bench_a[BENCH_N];
+static volatile int32_t bench_b[BENCH_N];
+
+// multiply-accumulate, like a fixed-point FIR/PI control loop (Q16)
+// the low 32 bits of the product are enough for the benchmark, unsigned so the wrap is defined
+static uint32_t kernel_mac() {
+    uint32_t acc = 0;
+    for (int i = 0; i < BENCH_N; i++)
+        acc += ((uint32_t)bench_a[i] * (uint32_t)bench_b[i]) >> 16;
+    return acc;
+}
+
+// duty cycle computation as in timer0_pwm_init()
+static int32_t kernel_pwm() {
+    int32_t acc = 0;
+    for (int i = 0; i < BENCH_N; i++)
+        acc += (bench_a[i] * (bench_b[i] & 0x7F)) / 100;
+    return acc;
+}
+
+// unsigned division and remainder, e.g. for decimal conversion
+static uint32_t kernel_div() {
+    uint32_t acc = 0;
+    for (int i = 0; i < BENCH_N; i++) {
+        uint32_t num = (uint32_t)bench_a[i] * 7919;
+        acc += num / 10 + num % 10;
+    }
+    return acc;
+}
+
+static void bench_report(const char *name, uint32_t cycles, uint32_t result) {
+    while (*name)
+        putchar(*name++);
+    printf(": 0x%x cycles (result 0x%x)\n", cycles, result);
+}
+
+int main() {
+    uart_init();
+
+    for (int i = 0; i < BENCH_N; i++) {
+        bench_a[i] = 0x10000 + i * 0x1234;
+        bench_b[i] = 0x8000 - i * 0x321;
+    }
+
+#ifdef __riscv_mul
+    printf("RV32M: hardware mul/div, %x iterations\n", BENCH_N);
+#else
+    printf("RV32I: libgcc mul/div, %x iterations\n", BENCH_N);
+#endif
+
+    uint32_t start, result;
+
+    start  = (uint32_t)get_mcycle();
+    result = kernel_mac();
+    bench_report("mac", (uint32_t)get_mcycle() - start, result);
+
+    start  = (uint32_t)get_mcycle();
+    result = kernel_pwm();
+    bench_report("pwm", (uint32_t)get_mcycle() - start, result);
+
+    start  = (uint32_t)get_mcycle();
+    result = kernel_div();
+    bench_report("div", (uint32_t)get_mcycle() - start, result);
+
+    uart_write_flush();
+    return 1;
+}
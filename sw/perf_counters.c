@@ -0,0 +1,68 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Profiles a few small kernels with the core performance counters (perf.h).
+// Build the hardware with HPM_COUNTERS=10 to get all event counts, otherwise only
+// cycles, instructions and CPI are meaningful.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "perf.h"
+#include "util.h"
+#include "config.h"
+
+#define PERF_BUF_WORDS 64
+
+static uint32_t perf_src[PERF_BUF_WORDS];
+static uint32_t perf_dst[PERF_BUF_WORDS];
+
+// load/store bound
+static void kernel_copy() {
+    for (int i = 0; i < PERF_BUF_WORDS; i++)
+        perf_dst[i] = perf_src[i];
+}
+
+// branch bound, data dependent branches
+static uint32_t kernel_branch() {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < 256; i++) {
+        if (i & 1) acc += i;
+        if ((i & 7) == 3) acc ^= acc << 1;
+    }
+    return acc;
+}
+
+int main() {
+    uart_init();
+    perf_t perf;
+
+    for (int i = 0; i < PERF_BUF_WORDS; i++)
+        perf_src[i] = i;
+
+    printf("HPM events: 0x%x 0x%x 0x%x\n", perf_get_event(3), perf_get_event(4),
+           perf_get_event(5));
+
+    PERF_BEGIN(perf);
+    kernel_copy();
+    PERF_END(perf);
+    perf_report("copy", &perf);
+
+    PERF_BEGIN(perf);
+    volatile uint32_t acc = kernel_branch();
+    PERF_END(perf);
+    perf_report("branch", &perf);
+    (void)acc;
+
+    // printf itself, UART bound
+    PERF_BEGIN(perf);
+    printf("0x%x\n", 0xC0C5);
+    uart_write_flush();
+    PERF_END(perf);
+    perf_report("printf", &perf);
+
+    uart_write_flush();
+    return 1;
+}
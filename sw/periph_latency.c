@@ -0,0 +1,92 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Peripheral access benchmark. For every subordinate on the peripheral bus it times
+// PERIPH_BENCH_N loads whose value is used right away (load-to-use latency, the core waits
+// for every response) and PERIPH_BENCH_N back-to-back stores (store throughput), both in
+// cycles per access. SRAM is listed as reference. Each peripheral is accessed through a
+// register that can be read and written back without side effects.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "timer.h"
+#include "gpio.h"
+#include "soc_ctrl.h"
+#include "pulser.h"
+#include "adv_timer.h"
+#include "util.h"
+#include "config.h"
+
+#define PERIPH_BENCH_N 16 // unrolled accesses per measurement
+
+#define REP4(x)  x x x x
+#define REP16(x) REP4(x) REP4(x) REP4(x) REP4(x)
+
+typedef struct {
+    const char *name;
+    volatile uint32_t *reg;
+} periph_bench_t;
+
+static volatile uint32_t sram_word;
+
+static inline __attribute__((always_inline)) uint32_t mcycle32() {
+    uint32_t mcycle;
+    asm volatile("csrr %0, mcycle" : "=r"(mcycle)::"memory");
+    return mcycle;
+}
+
+static void print_name(const char *name) {
+    int len = 0;
+    while (*name) {
+        putchar(*name++);
+        len++;
+    }
+    for (; len < 10; len++)
+        putchar(' ');
+}
+
+static void bench_periph(const periph_bench_t *p, uint32_t overhead) {
+    volatile uint32_t *reg = p->reg;
+    uint32_t value = *reg;
+    uint32_t acc = 0, start, load, store;
+
+    // every load feeds the next add, so each one waits for its response
+    start = mcycle32();
+    REP16(acc += *reg;)
+    load = mcycle32() - start - overhead;
+
+    start = mcycle32();
+    REP16(*reg = value;)
+    store = mcycle32() - start - overhead;
+
+    print_name(p->name);
+    printf(" load 0x%x, store 0x%x cycles/access (0x%x)\n", load / PERIPH_BENCH_N,
+           store / PERIPH_BENCH_N, acc & 0xF);
+}
+
+int main() {
+    uart_init();
+
+    const periph_bench_t periphs[] = {
+        { "SRAM",     &sram_word },
+        { "SocCtrl",  reg32(SOCCTRL_BASE_ADDR, SOC_CTRL_BOOTADDR_REG_OFFSET) },
+        { "Uart",     reg32(UART_BASE_ADDR, UART_SCRATCH_REG_OFFSET) },
+        { "Gpio",     reg32(GPIO_BASE_ADDR, GPIO_OUT_REG_OFFSET) },
+        { "Timer",    reg32(TIMER_BASE_ADDR, TIMER_CMP_HIGH_REG_OFFSET) },
+        { "Pulser",   reg32(PULSER_BASE_ADDR, 7 * PULSER_OFFSET_PER_ID + PULSER_CORE_CFG_F1_REG_OFFSET) },
+        { "AdvTimer", reg32(ADV_TIMER_BASE_ADDR, REG_TIM3_CH3_LUT) },
+    };
+
+    // cost of the two mcycle reads
+    uint32_t overhead = mcycle32();
+    overhead = mcycle32() - overhead;
+
+    for (unsigned i = 0; i < sizeof(periphs) / sizeof(periphs[0]); i++)
+        bench_periph(&periphs[i], overhead);
+
+    uart_write_flush();
+    return 1;
+}
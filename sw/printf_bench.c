@@ -0,0 +1,105 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// printf benchmark: cycles of the previous hex-only printf (copied below) against the current
+// one for the same line, and of decimal conversion by subtraction (format_dec32) against / and %,
+// which are libgcc loops on RV32I (build with RV32M=0 to see the difference).
+// The printf calls are timed in interrupt-driven UART mode, so they measure the CPU time until
+// the line is in the TX ring buffer and not the time on the wire.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "config.h"
+
+#define BENCH_N 8
+
+static volatile uint32_t bench_values[BENCH_N];
+
+// printf as it was before %d/%u/%s/%c support: %x only, one putchar per character
+static void printf_legacy(char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    char buffer[12];
+    uint8_t idx;
+
+    while (*fmt) {
+        if (*fmt == '%') {
+            fmt++;
+            if (*fmt == 'x') {
+                idx = format_hex32(buffer, va_arg(args, unsigned int));
+                for (int j = 0; j < idx; j++)
+                    putchar(buffer[j]);
+            }
+        } else {
+            putchar(*fmt);
+        }
+        fmt++;
+    }
+    va_end(args);
+}
+
+static uint8_t format_dec32_div(char *buffer, uint32_t num) {
+    char tmp[10];
+    uint8_t len = 0;
+    do {
+        tmp[len++] = '0' + num % 10;
+        num /= 10;
+    } while (num);
+    for (uint8_t i = 0; i < len; i++)
+        buffer[i] = tmp[len - 1 - i];
+    return len;
+}
+
+int main() {
+    uart_init();
+    char buffer[12];
+    uint32_t start, cycles, sum;
+
+    for (int i = 0; i < BENCH_N; i++)
+        bench_values[i] = 0x9E3779B9u >> (i * 4);
+
+    // decimal conversion
+    sum = 0;
+    start = (uint32_t)get_mcycle();
+    for (int i = 0; i < BENCH_N; i++)
+        sum += format_dec32_div(buffer, bench_values[i]);
+    cycles = (uint32_t)get_mcycle() - start;
+    printf("dec / %%: %u cycles for %u numbers (%u digits)\n", cycles, BENCH_N, sum);
+
+    sum = 0;
+    start = (uint32_t)get_mcycle();
+    for (int i = 0; i < BENCH_N; i++)
+        sum += format_dec32(buffer, bench_values[i]);
+    cycles = (uint32_t)get_mcycle() - start;
+    printf("dec sub: %u cycles for %u numbers (%u digits)\n", cycles, BENCH_N, sum);
+
+    // the same line through both printf versions
+    uart_async_enable();
+    uart_write_flush();
+    start = (uint32_t)get_mcycle();
+    printf_legacy("ch 0x%x: cnt 0x%x th 0x%x\n", 3, bench_values[1], bench_values[4]);
+    cycles = (uint32_t)get_mcycle() - start;
+    uart_write_flush();
+    printf("legacy printf: %u cycles\n", cycles);
+
+    uart_write_flush();
+    start = (uint32_t)get_mcycle();
+    printf("ch 0x%x: cnt 0x%x th 0x%x\n", 3, bench_values[1], bench_values[4]);
+    cycles = (uint32_t)get_mcycle() - start;
+    uart_write_flush();
+    printf("printf: %u cycles\n", cycles);
+
+    uart_write_flush();
+    start = (uint32_t)get_mcycle();
+    printf("ch %u: cnt %10u th %08x\n", 3, bench_values[1], bench_values[4]);
+    cycles = (uint32_t)get_mcycle() - start;
+    uart_write_flush();
+    printf("printf %%u/%%08x: %u cycles\n", cycles);
+
+    uart_write_flush();
+    return 1;
+}
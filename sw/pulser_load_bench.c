@@ -0,0 +1,101 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Pulser reprogramming benchmark: loads a waveform into all 8 instances and enables them, once
+// with pulser_config() per instance and a read-modify-write of the enable register, and once with
+// precomputed register images (PULSER_IMAGE, pulser_load_images) and the SRAM copy of the enable
+// mask. The registers are read back after each run to check that both give the same result.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "pulser.h"
+#include "util.h"
+#include "config.h"
+
+static const pulser_settings_t bench_settings[N_PULSERS] = {
+    {7, 3, 9, 6, 8, 5, 2, 0, 0},
+    {8, 4, 6, 2, 1, 9, 3, 0, 1},
+    {9, 5, 7, 3, 2, 4, 6, 1, 0},
+    {6, 2, 8, 5, 7, 1, 9, 1, 1},
+    {70, 30, 90, 60, 80, 50, 20, 0, 0},
+    {80, 40, 60, 20, 10, 90, 30, 0, 1},
+    {900, 500, 700, 300, 20, 40, 60, 1, 0},
+    {600, 200, 800, 500, 70, 10, 90, 1, 1},
+};
+
+static const pulser_image_t bench_images[N_PULSERS] = {
+    PULSER_IMAGE(7, 3, 9, 6, 8, 5, 2, 0, 0),
+    PULSER_IMAGE(8, 4, 6, 2, 1, 9, 3, 0, 1),
+    PULSER_IMAGE(9, 5, 7, 3, 2, 4, 6, 1, 0),
+    PULSER_IMAGE(6, 2, 8, 5, 7, 1, 9, 1, 1),
+    PULSER_IMAGE(70, 30, 90, 60, 80, 50, 20, 0, 0),
+    PULSER_IMAGE(80, 40, 60, 20, 10, 90, 30, 0, 1),
+    PULSER_IMAGE(900, 500, 700, 300, 20, 40, 60, 1, 0),
+    PULSER_IMAGE(600, 200, 800, 500, 70, 10, 90, 1, 1),
+};
+
+static pulser_image_t bench_runtime[N_PULSERS];
+
+// the way pulser_en used to do it
+static void en_rmw(uint32_t mask) {
+    volatile uint32_t *cfg = reg32(PULSER_BASE_ADDR, PULSER_OFFSET_PER_ID * N_PULSERS +
+                                                         PULSER_GENERAL_CFG_REG_OFFSET);
+    *cfg = *cfg | mask;
+}
+
+static void clear_all(void) {
+    static const pulser_image_t zero[N_PULSERS];
+    pulser_dis(0xFF);
+    pulser_load_images(zero, 0xFF);
+}
+
+// number of registers that differ from bench_images
+static int check_all(void) {
+    int errors = 0;
+    for (int id = 0; id < N_PULSERS; id++) {
+        volatile uint32_t *core = reg32(PULSER_BASE_ADDR, id * PULSER_OFFSET_PER_ID);
+        errors += core[PULSER_CORE_CFG_F1_REG_OFFSET / 4] != bench_images[id].f1;
+        errors += core[PULSER_CORE_CFG_F2_REG_OFFSET / 4] != bench_images[id].f2;
+        errors += core[PULSER_CORE_CFG_CNT_REG_OFFSET / 4] != bench_images[id].cnt;
+        errors += core[PULSER_CORE_CTRL_OUT_REG_OFFSET / 4] != bench_images[id].ctrl_out;
+    }
+    errors += *reg32(PULSER_BASE_ADDR, PULSER_OFFSET_PER_ID * N_PULSERS +
+                                           PULSER_GENERAL_CFG_REG_OFFSET) != 0xFF;
+    return errors;
+}
+
+int main() {
+    uart_init();
+    uint32_t start, cycles;
+
+    clear_all();
+    start = (uint32_t)get_mcycle();
+    for (int id = 0; id < N_PULSERS; id++)
+        pulser_config((pulser_id_t)id, &bench_settings[id]);
+    en_rmw(0xFF);
+    cycles = (uint32_t)get_mcycle() - start;
+    printf("pulser_config x8 + rmw enable: %4u cycles, errors %u\n", cycles, check_all());
+
+    clear_all();
+    start = (uint32_t)get_mcycle();
+    for (int id = 0; id < N_PULSERS; id++)
+        pulser_image_make(&bench_runtime[id], &bench_settings[id]);
+    pulser_load_images(bench_runtime, 0xFF);
+    pulser_en(0xFF);
+    cycles = (uint32_t)get_mcycle() - start;
+    printf("pulser_image_make x8 + load:   %4u cycles, errors %u\n", cycles, check_all());
+
+    clear_all();
+    start = (uint32_t)get_mcycle();
+    pulser_load_images(bench_images, 0xFF);
+    pulser_en(0xFF);
+    cycles = (uint32_t)get_mcycle() - start;
+    printf("pulser_load_images (const):    %4u cycles, errors %u\n", cycles, check_all());
+
+    pulser_dis(0xFF);
+    uart_write_flush();
+    return 1;
+}
@@ -0,0 +1,82 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// C++ register templates (reg.hpp, periph_regs.hpp) against the C drivers: the same pulser,
+// adv timer and GPIO setup once through each, timed in cycles. Each setup is a separate function,
+// compare their code with `riscv64-unknown-elf-nm --size-sort -S bin/regs_cxx.elf` or in
+// bin/regs_cxx.dump: the template versions are one constant store per register.
+// Also checks that crt0 ran the static constructors.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "periph_regs.hpp"
+#include "print.h"
+#include "util.h"
+
+// set by a static constructor (crt0.S)
+struct BootInfo {
+    uint32_t cycle;
+    BootInfo() : cycle((uint32_t)get_mcycle()) {}
+};
+static BootInfo boot_info;
+
+using P = Pulser<1>;
+using T = AdvTimer<0>;
+
+__attribute__((noinline)) static void setup_c() {
+    pulser_settings_t settings;
+    settings.f1_end = 7;
+    settings.f1_switch = 3;
+    settings.f2_end = 9;
+    settings.f2_switch = 6;
+    settings.f1_count = 8;
+    settings.f2_count = 5;
+    settings.stop_count = 2;
+    settings.invert_out = 0;
+    settings.idle_high = 1;
+    pulser_config(PULSER_1, &settings);
+
+    adv_timer_set_range(0, 1, 100);
+    adv_timer_set_channel(0, 0, TIM_CH_MODE_SETRST, 30);
+    adv_timer_commit(1 << 0);
+
+    gpio_set_direction(0xF, 0xF);
+    gpio_enable(0xF);
+}
+
+// writes the registers directly, the adv timer driver's register copy needs adv_timer_sync() after
+__attribute__((noinline)) static void setup_cxx() {
+    P::CfgF1::write(P::CfgF1::Endval::val(7) | P::CfgF1::Switchval::val(3));
+    P::CfgF2::write(P::CfgF2::Endval::val(9) | P::CfgF2::Switchval::val(6));
+    P::CfgCnt::write(P::CfgCnt::F1::val(8) | P::CfgCnt::F2::val(5) | P::CfgCnt::CntStop::val(2));
+    P::CtrlOut::write(P::CtrlOut::IdleOut::val(1));
+
+    T::Th::write(T::Th::Bottom::val(1) | T::Th::Top::val(100));
+    T::ChTh<0>::write(T::ChTh<0>::Mode::val(TIM_CH_MODE_SETRST) | T::ChTh<0>::Threshold::val(30));
+    T::Cmd::write(T::Cmd::Update::val(1));
+
+    Gpio::Dir::modify({0xF, 0xF});
+    Gpio::En::modify({0xF, 0xF});
+}
+
+int main() {
+    uart_init();
+    uint32_t start, cycles_c, cycles_cxx;
+
+    start = (uint32_t)get_mcycle();
+    setup_c();
+    cycles_c = (uint32_t)get_mcycle() - start;
+
+    start = (uint32_t)get_mcycle();
+    setup_cxx();
+    cycles_cxx = (uint32_t)get_mcycle() - start;
+
+    printf("static constructor ran at cycle %u\n", boot_info.cycle);
+    printf("pulser %u: F1 %x, CNT %x, CTRL_OUT %x\n", 1u, P::CfgF1::read(), P::CfgCnt::read(),
+           P::CtrlOut::read());
+    printf("setup: C drivers %u cycles, C++ templates %u cycles\n", cycles_c, cycles_cxx);
+
+    uart_write_flush();
+    return 1;
+}
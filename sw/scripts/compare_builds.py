@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Compare two firmware builds (e.g. rv32i vs rv32ic) program by program.
+# Code size comes from the size.txt written by `make -C sw size BINDIR=...`,
+# cycles from running every program on the fast Verilator model (optional).
+#
+# Authors:
+# - Nico Canzani <ncanzani@student.ethz.ch>
+
+import argparse
+import re
+import subprocess
+import sys
+from pathlib import Path
+
+
+def read_sizes(bindir: Path) -> dict:
+    """program name -> text + data bytes (what has to fit into the SRAM)"""
+    sizes = {}
+    with open(bindir / "size.txt") as f:
+        next(f)  # header
+        for line in f:
+            text, data, _bss, _dec, _hex, name = line.split()
+            sizes[Path(name).stem] = int(text) + int(data)
+    return sizes
+
+
+def run_cycles(sim: Path, hexfile: Path, max_cycles: int):
+    """simulated cycles until the program wrote its return code, None on timeout"""
+    res = subprocess.run([str(sim.resolve()), f"+binary={hexfile.resolve()}",
+                          f"+max-cycles={max_cycles}"],
+                         cwd=sim.parent.parent, capture_output=True, text=True)
+    if "Simulation finished" not in res.stdout:
+        return None
+    m = re.search(r"\[SIM\] (\d+) cycles", res.stdout)
+    return int(m.group(1)) if m else None
+
+
+def delta(a, b) -> str:
+    if a is None or b is None or a == 0:
+        return "-"
+    return f"{100.0 * (b - a) / a:+.1f}%"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("base", type=Path, help="bin directory of the reference build")
+    parser.add_argument("other", type=Path, help="bin directory of the compared build")
+    parser.add_argument("--sim", type=Path, help="fast Verilator model (Vtb_croc_soc_fast)")
+    parser.add_argument("--max-cycles", type=int, default=5000000)
+    args = parser.parse_args()
+
+    base, other = read_sizes(args.base), read_sizes(args.other)
+    header = f"{'program':<20} {args.base.name:>10} {args.other.name:>10} {'size':>8}"
+    if args.sim:
+        header += f" {args.base.name:>10} {args.other.name:>10} {'cycles':>8}"
+    print(header)
+    print("-" * len(header))
+
+    for prog in sorted(base.keys() & other.keys()):
+        line = f"{prog:<20} {base[prog]:>10} {other[prog]:>10} {delta(base[prog], other[prog]):>8}"
+        if args.sim:
+            ca = run_cycles(args.sim, args.base / f"{prog}.hex", args.max_cycles)
+            cb = run_cycles(args.sim, args.other / f"{prog}.hex", args.max_cycles)
+            line += f" {ca if ca is not None else 'timeout':>10}"
+            line += f" {cb if cb is not None else 'timeout':>10} {delta(ca, cb):>8}"
+        print(line)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
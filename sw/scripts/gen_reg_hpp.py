@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Generate the C++ register map (reg.hpp templates) from a regtool *_reg_defs.h header:
+# every <BLOCK>_<REG>_REG_OFFSET becomes a register struct with one Field per _MASK/_OFFSET
+# pair or _BIT define, nested in a <Block>Regs<Base> template.
+#
+#   gen_reg_hpp.py lib/inc/pulser_core_reg_defs.h > lib/inc/pulser_core_regs.hpp
+#
+# Authors:
+# - Nico Canzani <ncanzani@student.ethz.ch>
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+DEFINE_RE = re.compile(r"#define\s+(\w+)\s+(0x[0-9a-fA-F]+|\d+)\s*$")
+COMMENT_RE = re.compile(r"^//\s?(.*)$")
+
+
+def camel(name: str) -> str:
+    return "".join(part.capitalize() for part in name.lower().split("_"))
+
+
+def parse(path: Path):
+    """block name and [(register, offset, comment, [(field, offset, width)])]"""
+    text = path.read_text().splitlines()
+    block = re.search(r"Generated register defines for (\w+)", text[0]).group(1)
+    prefix = block.upper() + "_"
+    regs, comment, masks = [], [], {}
+    for line in text:
+        m = COMMENT_RE.match(line)
+        if m:
+            comment.append(m.group(1))
+            continue
+        m = DEFINE_RE.match(line)
+        if not m:
+            if not line.strip():
+                comment = []
+            continue
+        name, value = m.group(1)[len(prefix):], int(m.group(2), 0)
+        if name.endswith("_REG_OFFSET"):
+            regs.append((name[:-len("_REG_OFFSET")], value, " ".join(comment), []))
+            comment = []
+        elif regs and name.startswith(regs[-1][0] + "_"):
+            field = name[len(regs[-1][0]) + 1:]
+            if field.endswith("_BIT"):
+                regs[-1][3].append((field[:-4], value, 1))
+            elif field.endswith("_MASK"):
+                masks[field[:-5]] = value
+            elif field.endswith("_OFFSET"):
+                mask = masks.pop(field[:-7])
+                regs[-1][3].append((field[:-7], value, bin(mask).count("1")))
+    return block, regs
+
+
+def emit(path: Path, block: str, regs, out):
+    out.write(f"// Generated by sw/scripts/gen_reg_hpp.py from {path.name}, do not edit\n\n")
+    out.write("#pragma once\n\n#include \"reg.hpp\"\n\n")
+    out.write(f"template <uint32_t Base>\nstruct {camel(block)}Regs {{\n")
+    for i, (name, offset, comment, fields) in enumerate(regs):
+        addr = f"Base + 0x{offset:x}"
+        if i:
+            out.write("\n")
+        if comment:
+            out.write(f"    // {comment}\n")
+        out.write(f"    struct {camel(name)} : reg::Reg<{addr}> {{\n")
+        for field, off, width in fields:
+            out.write(f"        using {camel(field)} = reg::Field<{addr}, {off}, {width}>;\n")
+        out.write("    };\n")
+    out.write("};\n")
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("defs", type=Path, help="regtool generated *_reg_defs.h")
+    args = parser.parse_args()
+    block, regs = parse(args.defs)
+    emit(args.defs, block, regs, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
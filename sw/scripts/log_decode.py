@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Decode the binary LOG() records of sw/lib/inc/log.h against the .log_fmt section of the ELF.
+# Either a raw UART byte stream (file or stdin, plain text passes through) or a single record
+# given as hex bytes, which is how the testbench UART monitor calls it (tb_croc_soc.sv).
+#
+#   log_decode.py bin/helloworld.elf uart.bin
+#   log_decode.py bin/helloworld.elf --record 8210000700000000
+#
+# Authors:
+# - Nico Canzani <ncanzani@student.ethz.ch>
+
+import argparse
+import re
+import struct
+import sys
+from pathlib import Path
+
+RECORD_FLAG = 0x80
+FORMAT_RE = re.compile(r"%(0?)(\d*)([duxc%])")
+
+
+def read_log_section(elf: Path) -> tuple:
+    """(address, bytes) of the .log_fmt section, parsed straight from the ELF32 headers"""
+    data = elf.read_bytes()
+    if data[:4] != b"\x7fELF" or data[4] != 1:
+        sys.exit(f"{elf}: not an ELF32 file")
+    shoff, = struct.unpack_from("<I", data, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+
+    def section(idx):
+        # name, type, flags, addr, offset, size
+        return struct.unpack_from("<IIIIII", data, shoff + idx * shentsize)
+
+    strtab = section(shstrndx)
+    for idx in range(shnum):
+        name, _type, _flags, addr, offset, size = section(idx)
+        start = strtab[4] + name
+        if data[start:data.index(b"\0", start)] == b".log_fmt":
+            return addr, data[offset:offset + size]
+    sys.exit(f"{elf}: no .log_fmt section (no LOG() calls?)")
+
+
+def format_record(fmt: str, args: list) -> str:
+    """apply the printf subset of sw/lib/src/print.c to the raw 32-bit arguments"""
+    args = iter(args)
+
+    def conv(m):
+        pad, width, spec = m.groups()
+        if spec == "%":
+            return "%"
+        val = next(args, 0)
+        if spec == "d":
+            text = str(val - (1 << 32) if val & 0x80000000 else val)
+        elif spec == "u":
+            text = str(val)
+        elif spec == "x":
+            text = f"{val:X}"
+        else:
+            text = chr(val & 0xFF)
+        width = int(width or 0)
+        if pad and text.startswith("-"):
+            return "-" + text[1:].rjust(width - 1, "0")
+        return text.rjust(width, "0" if pad else " ")
+
+    return FORMAT_RE.sub(conv, fmt)
+
+
+class Decoder:
+    def __init__(self, elf: Path):
+        self.base, self.strings = read_log_section(elf)
+
+    def lookup(self, string_id: int) -> str:
+        offset = string_id - self.base
+        if not 0 <= offset < len(self.strings):
+            return f"<unknown LOG string 0x{string_id:x}>"
+        end = self.strings.index(b"\0", offset)
+        return self.strings[offset:end].decode(errors="replace")
+
+    def decode(self, record: bytes) -> str:
+        """one record, header included, to text"""
+        nargs = record[0] & 0x7F
+        string_id, = struct.unpack_from("<H", record, 1)
+        args = list(struct.unpack_from(f"<{nargs}I", record, 3))
+        return format_record(self.lookup(string_id), args)
+
+    def stream(self, data: bytes, out):
+        pos = 0
+        while pos < len(data):
+            if data[pos] & RECORD_FLAG:
+                length = 3 + 4 * (data[pos] & 0x7F)
+                if pos + length > len(data):
+                    out.write("<truncated LOG record>\n")
+                    return
+                out.write(self.decode(data[pos:pos + length]))
+                pos += length
+            else:
+                out.write(chr(data[pos]))
+                pos += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("elf", type=Path, help="firmware ELF with the .log_fmt section")
+    parser.add_argument("input", nargs="?", type=Path,
+                        help="raw UART output, default stdin")
+    parser.add_argument("--record", help="decode a single record given as hex bytes")
+    args = parser.parse_args()
+
+    decoder = Decoder(args.elf)
+    if args.record:
+        print(decoder.decode(bytes.fromhex(args.record)).rstrip("\n"))
+        return
+    data = args.input.read_bytes() if args.input else sys.stdin.buffer.read()
+    decoder.stream(data, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
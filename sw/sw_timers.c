@@ -0,0 +1,55 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Software timer demo (timer.h): two periodic timers and a one-shot timeout run concurrently
+// while the core sleeps in timer_sleep_us(). Prints how often each fired and how late the
+// callbacks ran after their deadline, in microseconds.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "timer.h"
+#include "gpio.h"
+#include "util.h"
+#include "config.h"
+
+typedef struct {
+    sw_timer_t timer;
+    uint32_t count;
+    uint32_t max_late; // us between deadline and callback
+} demo_timer_t;
+
+static demo_timer_t fast, slow, once;
+
+static void demo_callback(void *arg) {
+    demo_timer_t *d = arg;
+    // the deadline was already advanced for periodic timers
+    uint32_t late = timer_now_us() - (d->timer.deadline - d->timer.period);
+    if (late > d->max_late)
+        d->max_late = late;
+    d->count++;
+    gpio_toggle(1 << 0);
+}
+
+int main() {
+    uart_init();
+    gpio_set_direction(1 << 0, 1 << 0);
+    gpio_enable(1 << 0);
+
+    timer_add(&fast.timer, 50, 50, demo_callback, &fast);
+    timer_add(&slow.timer, 120, 120, demo_callback, &slow);
+    timer_add(&once.timer, 333, 0, demo_callback, &once);
+
+    timer_sleep_us(1000);
+    timer_cancel(&fast.timer);
+    timer_cancel(&slow.timer);
+
+    printf("fast: 0x%x runs, late 0x%x us\n", fast.count, fast.max_late);
+    printf("slow: 0x%x runs, late 0x%x us\n", slow.count, slow.max_late);
+    printf("once: 0x%x runs, late 0x%x us\n", once.count, once.max_late);
+
+    uart_write_flush();
+    return 1;
+}
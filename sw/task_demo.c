@@ -0,0 +1,143 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Cooperative task demo (task.h): three tasks overlap on one core
+// - pulser: queues PULSER_TRAINS trains on pulser 0 and waits for each completion interrupt
+// - monitor: samples the adv timer 0 counter every MONITOR_US and counts the PWM periods
+// - log: writes a status line every LOG_US through the UART TX ring buffer
+// At the end it prints the elapsed time and how much of it the core slept in wfi instead of
+// busy-waiting on the peripherals, in microseconds.
+//
+// Nico Canzani <ncanzani@student.ethz.ch>
+
+#include "uart.h"
+#include "print.h"
+#include "task.h"
+#include "timer.h"
+#include "pulser.h"
+#include "adv_timer.h"
+#include "util.h"
+#include "config.h"
+
+#define PULSER_TRAINS 8
+#define PULSER_GAP_US 20
+#define MONITOR_US    50
+#define LOG_US        200
+#define PWM_PERIOD_US 100 // more than 2 * MONITOR_US so the monitor sees every wrap
+#define PWM_TICKS     (TB_FREQUENCY / 1000000 * PWM_PERIOD_US)
+
+#define EV_PULSER_DONE (1 << 0)
+
+static task_t *pulser_task;
+static uint32_t trains;      // completed pulser trains
+static uint32_t periods;     // adv timer 0 periods seen by the monitor
+static int last_counter;
+static uint8_t pulser_done;  // pulser task exited
+
+// longest line: "t=0x" + 8 + " trains=0x" + 8 + " periods=0x" + 8 + "\n"
+static char log_line[4 + 8 + 10 + 8 + 11 + 8 + 1];
+static uint32_t log_len;
+
+static void demo_pulser_done(uint32_t done_mask) {
+    task_signal(pulser_task, EV_PULSER_DONE);
+}
+
+static int pulser_fn(task_t *t) {
+    TASK_BEGIN(t);
+    while (trains < PULSER_TRAINS) {
+        pulser_start(1 << PULSER_0);
+        TASK_WAIT_EVENT(t, EV_PULSER_DONE);
+        trains++;
+        TASK_SLEEP_US(t, PULSER_GAP_US);
+    }
+    pulser_irq_disable(1 << PULSER_0);
+    pulser_done = 1;
+    TASK_END(t);
+}
+
+static int monitor_fn(task_t *t) {
+    TASK_BEGIN(t);
+    while (!pulser_done) {
+        TASK_SLEEP_US(t, MONITOR_US);
+        int counter = adv_timer_get_counter(0);
+        if (counter < last_counter)
+            periods++;
+        last_counter = counter;
+    }
+    TASK_END(t);
+}
+
+static void log_append(const char *s) {
+    while (*s)
+        log_line[log_len++] = *s++;
+}
+
+static void log_hex(uint32_t num) {
+    log_len += format_hex32(log_line + log_len, num);
+}
+
+static int log_fn(task_t *t) {
+    TASK_BEGIN(t);
+    do {
+        TASK_SLEEP_US(t, LOG_US);
+        log_len = 0;
+        log_append("t=0x");
+        log_hex(timer_now_us());
+        log_append(" trains=0x");
+        log_hex(trains);
+        log_append(" periods=0x");
+        log_hex(periods);
+        log_append("\n");
+        TASK_WAIT_UNTIL(t, uart_write_space() >= log_len);
+        uart_write_async(log_line, log_len);
+    } while (!pulser_done);
+    TASK_END(t);
+}
+
+int main() {
+    uart_init();
+    uart_async_enable();
+    timer_init();
+
+    pulser_settings_t settings;
+    settings.f1_end = 7;
+    settings.f1_switch = 3;
+    settings.f2_end = 9;
+    settings.f2_switch = 6;
+    settings.f1_count = 8;
+    settings.f2_count = 5;
+    settings.stop_count = 2;
+    settings.invert_out = 0;
+    settings.idle_high = 0;
+    pulser_config(PULSER_0, &settings);
+    pulser_en(1 << PULSER_0);
+
+    // PWM from the system clock, adv_timer_pwm_init() counts the 32 kHz reference clock whose
+    // periods are longer than the whole demo
+    adv_timer_reset(0);
+    adv_timer_config(0, TIM_CFG_SEL_CLK_SRC);
+    adv_timer_clk_enable(1 << 0);
+    adv_timer_set_channel(0, 0, TIM_CH_MODE_SETRST, PWM_TICKS / 2);
+    adv_timer_set_range(0, 1, PWM_TICKS);
+    adv_timer_commit(1 << 0);
+    adv_timer_start(0);
+
+    pulser_task = task_create(pulser_fn, 0);
+    pulser_irq_enable(1 << PULSER_0, demo_pulser_done);
+    task_create(monitor_fn, 0);
+    task_create(log_fn, 0);
+
+    uint32_t start = timer_now_us();
+    uint32_t idle = task_run();
+    uint32_t elapsed = timer_now_us() - start;
+
+    adv_timer_stop(0);
+    pulser_dis(1 << PULSER_0);
+
+    printf("trains 0x%x, periods 0x%x\n", trains, periods);
+    printf("elapsed 0x%x us, idle 0x%x us, busy 0x%x us\n", elapsed, idle, elapsed - idle);
+
+    uart_write_flush();
+    return 1;
+}
@@ -0,0 +1,200 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Timing-free C++ harness for tb_croc_soc_fast.
+// Generates the system and reference clocks, preloads the binary, decodes the UART output
+// and reports the simulation speed at exit.
+//
+// Plusargs:
+// - +binary=<file.hex>  program to run (default: ../sw/bin/helloworld.hex)
+// - +max-cycles=<n>     abort after n system clock cycles (default: 0, no limit)
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Vtb_croc_soc_fast.h"
+#include "Vtb_croc_soc_fast__Dpi.h"
+#include "verilated.h"
+
+// Must match the parameters of tb_croc_soc and the firmware config (sw/config.h)
+static const uint64_t kClkPeriodPs = 50000;    // 20 MHz system clock
+static const uint64_t kRefPeriodPs = 30518000; // 32.768 kHz reference clock
+static const uint64_t kClkFrequency = 1000000000000ULL / kClkPeriodPs;
+static const uint64_t kUartBaudRate = 115200;
+static const uint64_t kUartBitCycles = (kClkFrequency / (kUartBaudRate * 16)) * 16;
+static const uint32_t kRstCycles = 4;
+static const uint32_t kFetchEnCycle = 10;
+
+///////////////////////
+// Binary preloading //
+///////////////////////
+
+static std::unordered_map<uint32_t, uint32_t> preload_words;
+
+// Parse the verilog hex file (objcopy -O verilog) into word aligned addresses
+static void load_hex(const std::string &filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        fprintf(stderr, "[PRELOAD] Error: Failed to open file %s\n", filename.c_str());
+        exit(EXIT_FAILURE);
+    }
+    std::string token;
+    uint32_t addr = 0;
+    while (file >> token) {
+        if (token[0] == '@') {
+            addr = (uint32_t)std::stoul(token.substr(1), nullptr, 16);
+            continue;
+        }
+        uint32_t byte = (uint32_t)std::stoul(token, nullptr, 16);
+        uint32_t &word = preload_words[addr & ~3u]; // zero-initialized on first access
+        word |= byte << (8 * (addr & 3u));
+        addr++;
+    }
+    printf("[PRELOAD] Loaded %zu words from %s\n", preload_words.size(), filename.c_str());
+}
+
+// DPI: called by the SRAM banks at time zero
+svBit sim_preload_word(int addr, int *data) {
+    auto it = preload_words.find((uint32_t)addr);
+    if (it == preload_words.end()) return 0;
+    *data = (int)it->second;
+    return 1;
+}
+
+//////////////////
+// UART monitor //
+//////////////////
+
+// Samples uart_tx_o once per system clock cycle and prints complete lines
+class UartMonitor {
+  public:
+    void sample(uint8_t tx, uint64_t time_ps) {
+        switch (state_) {
+        case Idle:
+            if (!tx) { // start bit
+                state_ = Data;
+                count_ = kUartBitCycles / 2 + kUartBitCycles; // middle of the first data bit
+                bit_ = 0;
+                byte_ = 0;
+            }
+            break;
+        case Data:
+            if (--count_ == 0) {
+                byte_ |= (tx & 1) << bit_;
+                count_ = kUartBitCycles;
+                if (++bit_ == 8) state_ = Stop;
+            }
+            break;
+        case Stop:
+            if (--count_ == 0) {
+                state_ = Idle;
+                receive(byte_, time_ps);
+            }
+            break;
+        }
+    }
+
+  private:
+    enum { Idle, Data, Stop } state_ = Idle;
+    uint64_t count_ = 0;
+    uint32_t bit_ = 0;
+    uint8_t byte_ = 0;
+    std::string line_;
+
+    void receive(uint8_t c, uint64_t time_ps) {
+        if (c == '\n' || line_.size() > 80) {
+            // same format as tb_croc_soc, keeps .github/scripts/check_sim.sh working
+            printf("@%10" PRIu64 "ns | [UART] %s\n", time_ps / 1000, line_.c_str());
+            line_.clear();
+        } else {
+            line_.push_back((char)c);
+        }
+    }
+};
+
+//////////
+// Main //
+//////////
+
+int main(int argc, char **argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+
+    std::string binary_path = "../sw/bin/helloworld.hex";
+    const char *arg = contextp->commandArgsPlusMatch("binary=");
+    if (arg[0]) binary_path = std::string(arg).substr(sizeof("+binary=") - 1);
+    printf("Running program: %s\n", binary_path.c_str());
+
+    uint64_t max_cycles = 0;
+    arg = contextp->commandArgsPlusMatch("max-cycles=");
+    if (arg[0]) max_cycles = std::stoull(std::string(arg).substr(sizeof("+max-cycles=") - 1));
+
+    load_hex(binary_path);
+
+    const std::unique_ptr<Vtb_croc_soc_fast> top{new Vtb_croc_soc_fast{contextp.get()}};
+    UartMonitor uart;
+
+    top->clk_i = 0;
+    top->ref_clk_i = 0;
+    top->rst_ni = 0;
+    top->fetch_en_i = 0;
+    top->uart_rx_i = 1;
+
+    uint64_t time_ps = 0;
+    uint64_t next_ref_toggle = kRefPeriodPs / 2;
+    uint64_t cycles = 0;
+    uint32_t exit_code = 0;
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    top->eval();
+
+    while (!contextp->gotFinish()) {
+        // advance by half a system clock period, toggle the reference clock in between
+        time_ps += kClkPeriodPs / 2;
+        if (time_ps >= next_ref_toggle) {
+            top->ref_clk_i = !top->ref_clk_i;
+            next_ref_toggle += kRefPeriodPs / 2;
+        }
+        top->clk_i = !top->clk_i;
+        contextp->time(time_ps);
+        top->eval();
+        if (!top->clk_i) continue;
+
+        // rising edge: cycle based stimuli
+        cycles++;
+        if (cycles == kRstCycles) top->rst_ni = 1;
+        if (cycles == kFetchEnCycle) {
+            printf("@%10" PRIu64 "ns | [CORE] Start fetching instructions\n", time_ps / 1000);
+            top->fetch_en_i = 1;
+        }
+        if (top->fetch_en_i) uart.sample(top->uart_tx_o, time_ps);
+
+        exit_code = top->exit_code_o;
+        if (exit_code != 0) {
+            printf("@%10" PRIu64 "ns | [CORE] Simulation finished: return code 0x%x\n",
+                   time_ps / 1000, exit_code);
+            break;
+        }
+        if (max_cycles && cycles >= max_cycles) {
+            printf("@%10" PRIu64 "ns | [CORE] Timeout after %" PRIu64 " cycles\n", time_ps / 1000,
+                   cycles);
+            break;
+        }
+    }
+
+    const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wall_start;
+    top->final();
+
+    const double cycles_per_s = wall.count() > 0 ? cycles / wall.count() : 0.0;
+    printf("[SIM] %" PRIu64 " cycles in %.3f s: %.0f cycles/s (%.2f kHz), %u threads\n", cycles,
+           wall.count(), cycles_per_s, cycles_per_s / 1000.0, contextp->threads());
+
+    return exit_code == 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}